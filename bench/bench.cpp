@@ -0,0 +1,510 @@
+#include "../generator/formula_generator.h"
+#include "../solver/parser.h"
+#include "../solver/evaluator.h"
+#include "../solver/bitslice.h"
+#include "../solver/compiled.h"
+#include "../solver/incremental.h"
+#include "../solver/tseitin.h"
+#include "../solver/bdd.h"
+#include "../solver/shannon.h"
+#include "../solver/jit.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+// Parâmetros da linha de comando
+struct BenchConfig {
+    int warmup;
+    int repeat;
+    bool quick;
+    std::string filter;
+    std::string output;
+    std::string solver;
+    std::string workDir;
+
+    BenchConfig() : warmup(1), repeat(5), quick(false), output("bench_results.json"),
+                    solver("bin/solver"), workDir("build/bench") {}
+};
+
+// Um benchmark: o tempo de cada repetição, já dividido pelo número de operações
+struct BenchResult {
+    std::string suite;
+    std::string name;
+    std::string operation;      // O que uma operação mede ("fórmula", "atribuição", ...)
+    std::vector<double> nanos;  // ns por operação em cada repetição
+    double opsPerRun;
+    double bytesPerRun;         // 0 se não se aplica
+
+    double percentile(double p) const {
+        // Posto mais próximo: com poucas repetições o p99 é o máximo
+        std::vector<double> sorted = nanos;
+        std::sort(sorted.begin(), sorted.end());
+        size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+        return sorted[rank > 0 ? rank - 1 : 0];
+    }
+
+    double median() const {
+        std::vector<double> sorted = nanos;
+        std::sort(sorted.begin(), sorted.end());
+        size_t n = sorted.size();
+        return (n % 2) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+    }
+
+    double minimum() const { return *std::min_element(nanos.begin(), nanos.end()); }
+
+    double mean() const {
+        double sum = 0;
+        for (double x : nanos) sum += x;
+        return sum / nanos.size();
+    }
+};
+
+// Corpus de instâncias com a mesma sequência de `generator N min max prof seed`
+struct Corpus {
+    std::string name;
+    int seed;
+    int count;
+    int minVars;
+    int maxVars;
+    int depth;
+    std::vector<std::string> formulas;
+    std::vector<std::string> types;
+    std::string path;
+};
+
+static void generateCorpus(Corpus& corpus) {
+    FormulaGenerator generator(corpus.seed, corpus.minVars, corpus.maxVars, corpus.depth);
+    int tautologyCount = (int)(corpus.count * 0.7);
+    int contradictionCount = (int)(corpus.count * 0.2);
+    for (int i = 0; i < corpus.count; ++i) {
+        if (i < tautologyCount) {
+            corpus.formulas.push_back(generator.generateTautology());
+            corpus.types.push_back("TAUTOLOGY");
+        } else if (i < tautologyCount + contradictionCount) {
+            corpus.formulas.push_back(generator.generateContradiction());
+            corpus.types.push_back("CONTRADICTION");
+        } else {
+            corpus.formulas.push_back(generator.generateFormula());
+            corpus.types.push_back("RANDOM");
+        }
+    }
+}
+
+static void writeCorpus(Corpus& corpus, const std::string& dir) {
+    corpus.path = dir + "/" + corpus.name + ".txt";
+    std::ofstream file(corpus.path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Não foi possível criar o arquivo: " + corpus.path);
+    }
+    file << "# Arquivo de Instâncias de Tautologias Booleanas" << std::endl;
+    file << "# Corpus do bench: " << corpus.count << " instâncias, " << corpus.minVars << "-" << corpus.maxVars
+         << " variáveis, profundidade " << corpus.depth << ", seed " << corpus.seed << std::endl;
+    file << "# Formato: INSTANCE_ID|FORMULA|TYPE|NUM_VARS" << std::endl;
+    file << "#" << std::endl;
+    for (size_t i = 0; i < corpus.formulas.size(); ++i) {
+        file << std::setfill('0') << std::setw(3) << i << "|" << corpus.formulas[i] << "|" << corpus.types[i]
+             << "|" << FormulaGenerator::collectVariables(corpus.formulas[i]).size() << std::endl;
+    }
+}
+
+static void makeDirectory(const std::string& path) {
+    // Cria cada componente do caminho (build/bench)
+    for (size_t i = 1; i <= path.size(); ++i) {
+        if (i == path.size() || path[i] == '/') {
+#ifdef _WIN32
+            _mkdir(path.substr(0, i).c_str());
+#else
+            mkdir(path.substr(0, i).c_str(), 0755);
+#endif
+        }
+    }
+}
+
+class BenchRunner {
+private:
+    const BenchConfig& config;
+
+public:
+    std::vector<BenchResult> results;
+
+    explicit BenchRunner(const BenchConfig& c) : config(c) {}
+
+    bool selected(const std::string& name) const {
+        return config.filter.empty() || name.find(config.filter) != std::string::npos;
+    }
+
+    // Executa body warmup + repeat vezes; só as repetições entram no resultado.
+    // body faz opsPerRun operações.
+    void run(const std::string& suite, const std::string& name, const std::string& operation,
+             double opsPerRun, double bytesPerRun, const std::function<void()>& body) {
+        if (!selected(name)) return;
+
+        BenchResult result;
+        result.suite = suite;
+        result.name = name;
+        result.operation = operation;
+        result.opsPerRun = opsPerRun;
+        result.bytesPerRun = bytesPerRun;
+
+        for (int i = 0; i < config.warmup + config.repeat; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            body();
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            if (i >= config.warmup) {
+                result.nanos.push_back(static_cast<double>(elapsed) / opsPerRun);
+            }
+        }
+
+        print(result);
+        results.push_back(result);
+    }
+
+    static std::string formatNanos(double ns) {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(ns < 10 ? 2 : 1);
+        if (ns >= 1e9) {
+            text << ns / 1e9 << " s";
+        } else if (ns >= 1e6) {
+            text << ns / 1e6 << " ms";
+        } else if (ns >= 1e3) {
+            text << ns / 1e3 << " μs";
+        } else {
+            text << ns << " ns";
+        }
+        return text.str();
+    }
+
+    // Alinha à direita contando caracteres, não bytes ("μs" tem 3 bytes)
+    static std::string padLeft(const std::string& text, size_t width) {
+        size_t length = 0;
+        for (char c : text) {
+            if ((static_cast<unsigned char>(c) & 0xC0) != 0x80) length++;
+        }
+        return std::string(length < width ? width - length : 0, ' ') + text;
+    }
+
+    static void print(const BenchResult& r) {
+        std::cout << std::left << std::setw(36) << r.name << std::right
+                  << " mediana " << padLeft(formatNanos(r.median()), 10)
+                  << "  p99 " << padLeft(formatNanos(r.percentile(0.99)), 10)
+                  << "  por " << r.operation;
+        if (r.bytesPerRun > 0) {
+            double mbPerSecond = r.bytesPerRun / (r.median() * r.opsPerRun) * 1e3;
+            std::cout << "  (" << std::fixed << std::setprecision(1) << mbPerSecond << " MB/s)";
+        }
+        std::cout << std::endl;
+    }
+};
+
+static std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+static void writeJson(const BenchConfig& config, const std::vector<BenchResult>& results) {
+    std::ofstream file(config.output);
+    if (!file.is_open()) {
+        throw std::runtime_error("Não foi possível criar o arquivo: " + config.output);
+    }
+
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    file << std::setprecision(6);
+    file << "{\n";
+    file << "  \"schema\": 1,\n";
+    file << "  \"timestamp\": " << jsonString(date) << ",\n";
+    file << "  \"config\": {\"warmup\": " << config.warmup << ", \"repeat\": " << config.repeat
+         << ", \"quick\": " << (config.quick ? "true" : "false") << "},\n";
+    file << "  \"system\": {\"threads\": " << std::thread::hardware_concurrency()
+         << ", \"simd\": " << jsonString(SimdDispatch::best().name)
+         << ", \"jit\": " << (JitProgram::supported() ? "true" : "false") << "},\n";
+    file << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        file << "    {\"suite\": " << jsonString(r.suite) << ", \"name\": " << jsonString(r.name)
+             << ", \"unit\": \"ns\", \"ops_per_run\": " << r.opsPerRun
+             << ", \"median\": " << r.median() << ", \"p99\": " << r.percentile(0.99)
+             << ", \"min\": " << r.minimum() << ", \"mean\": " << r.mean();
+        if (r.bytesPerRun > 0) {
+            file << ", \"bytes_per_run\": " << r.bytesPerRun;
+        }
+        file << ", \"runs\": [";
+        for (size_t k = 0; k < r.nanos.size(); ++k) {
+            file << (k ? ", " : "") << r.nanos[k];
+        }
+        file << "]}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n";
+    file << "}\n";
+}
+
+static AST parseFormula(const std::string& formula) {
+    Parser parser(formula, true);
+    AST ast = parser.parse();
+    ast.sortVariables();
+    return ast;
+}
+
+// Tautologia com exatamente n variáveis e a varredura inteira: F ∨ ¬F. Os
+// motores simbólicos a decidem pela estrutura, sem olhar F; só serve para
+// comparar os que enumeram a tabela-verdade.
+static std::string sweepFormula(int numVars) {
+    FormulaGenerator generator(1000 + numVars, numVars, numVars, 6);
+    std::string f = generator.generateFormulaWithAllVars(numVars);
+    return "(" + f + " ∨ ¬" + f + ")";
+}
+
+// Casa dos pombos: ¬(cada pombo numa casa ∧ nenhuma casa com dois pombos),
+// tautologia com pigeons > holes e pigeons · holes variáveis (x<pombo>_<casa>).
+// Não tem atalho estrutural: a enumeração varre tudo, a resolução do SAT é
+// exponencial nela e o BDD e a expansão de Shannon também crescem.
+static std::string pigeonholeFormula(int pigeons, int holes) {
+    auto var = [](int pigeon, int hole) {
+        return "x" + std::to_string(pigeon) + "_" + std::to_string(hole);
+    };
+    std::string placed;
+    for (int p = 0; p < pigeons; ++p) {
+        std::string somewhere = var(p, 0);
+        for (int h = 1; h < holes; ++h) {
+            somewhere = "(" + somewhere + " ∨ " + var(p, h) + ")";
+        }
+        placed = placed.empty() ? somewhere : "(" + placed + " ∧ " + somewhere + ")";
+    }
+    std::string exclusive;
+    for (int h = 0; h < holes; ++h) {
+        for (int p = 0; p < pigeons; ++p) {
+            for (int q = p + 1; q < pigeons; ++q) {
+                const std::string apart = "¬(" + var(p, h) + " ∧ " + var(q, h) + ")";
+                exclusive = exclusive.empty() ? apart : "(" + exclusive + " ∧ " + apart + ")";
+            }
+        }
+    }
+    return "¬(" + placed + " ∧ " + exclusive + ")";
+}
+
+// Vazão do Parser sobre os corpora
+static void benchParse(BenchRunner& runner, const std::vector<Corpus>& corpora) {
+    for (const Corpus& corpus : corpora) {
+        double bytes = 0;
+        for (const std::string& f : corpus.formulas) bytes += f.size();
+        runner.run("parse", "parse/" + corpus.name, "fórmula", corpus.formulas.size(), bytes, [&]() {
+            for (const std::string& f : corpus.formulas) {
+                Parser parser(f, true);
+                AST ast = parser.parse();
+                if (ast.empty()) throw std::runtime_error("Fórmula vazia no corpus");
+            }
+        });
+    }
+}
+
+// Custo de Evaluator::evaluate por atribuição
+static void benchEvaluate(BenchRunner& runner, const BenchConfig& config) {
+    const int sizes[] = { 8, 16, 24 };
+    const int evaluations = config.quick ? 20000 : 100000;
+    for (int n : sizes) {
+        AST ast = parseFormula(sweepFormula(n));
+        std::vector<std::vector<bool> > rows(256, std::vector<bool>(n));
+        for (size_t r = 0; r < rows.size(); ++r) {
+            for (int j = 0; j < n; ++j) {
+                rows[r][j] = ((r * 2654435761u) >> (j % 32)) & 1;
+            }
+        }
+
+        Evaluator evaluator;
+        evaluator.prepare(ast);
+        std::ostringstream name;
+        name << "evaluate/" << n << "vars/" << ast.size() << "nos";
+        runner.run("evaluate", name.str(), "atribuição", evaluations, 0, [&]() {
+            bool all = true;
+            for (int i = 0; i < evaluations; ++i) {
+                evaluator.setAssignment(rows[i & 255]);
+                all = evaluator.evaluate(ast) && all;
+            }
+            if (!all) throw std::runtime_error("F ∨ ¬F avaliou como falso");
+        });
+    }
+}
+
+// Verificação completa por motor: F ∨ ¬F de 4 a 26 variáveis nos motores
+// que enumeram e a casa dos pombos em todos
+static void benchCheck(BenchRunner& runner, const BenchConfig& config) {
+    struct Engine {
+        const char* name;
+        int maxVars;        // Motores que enumeram linha a linha param antes
+        bool enumerates;    // Só estes entram no F ∨ ¬F
+        std::function<bool(const AST&)> check;
+    };
+    const std::vector<Engine> engines = {
+        { "bruteforce", 20, true, [](const AST& ast) { Evaluator e; return e.isTautology(ast); } },
+        { "compiled", 22, true, [](const AST& ast) {
+            CompiledFormula program(ast);
+            CompiledEvaluator e;
+            return e.isTautology(program);
+        } },
+        { "gray", 22, true, [](const AST& ast) { IncrementalEvaluator e; return e.isTautology(ast); } },
+        { "bitslice", 26, true, [](const AST& ast) { BitSliceEvaluator e; return e.isTautology(ast); } },
+        { "bitslice-nojit", 26, true, [](const AST& ast) {
+            BitSliceEvaluator e;
+            e.setJit(false);
+            return e.isTautology(ast);
+        } },
+        { "sat", 63, false, [](const AST& ast) { SatEvaluator e; return e.isTautology(ast); } },
+        { "bdd", 63, false, [](const AST& ast) { BddEvaluator e; return e.isTautology(ast); } },
+        { "shannon", 63, false, [](const AST& ast) { ShannonEvaluator e; return e.isTautology(ast); } },
+    };
+
+    std::vector<int> sizes = config.quick ? std::vector<int>{ 4, 8, 12, 16, 20 }
+                                          : std::vector<int>{ 4, 8, 12, 16, 20, 22, 24, 26 };
+    for (int n : sizes) {
+        AST ast = parseFormula(sweepFormula(n));
+        for (const Engine& engine : engines) {
+            if (!engine.enumerates || n > engine.maxVars) continue;
+            std::ostringstream name;
+            name << "check/" << engine.name << "/" << n << "vars";
+            runner.run("check", name.str(), "verificação", 1, 0, [&]() {
+                if (!engine.check(ast)) throw std::runtime_error(name.str() + ": F ∨ ¬F não é tautologia");
+            });
+        }
+    }
+
+    // Pombos e casas: 6, 12, 20, 30, 42 e 56 variáveis; acima de 26 só os simbólicos
+    std::vector<int> holeCounts = config.quick ? std::vector<int>{ 2, 3, 4 } : std::vector<int>{ 2, 3, 4, 5, 6, 7 };
+    for (int holes : holeCounts) {
+        const int pigeons = holes + 1;
+        AST ast = parseFormula(pigeonholeFormula(pigeons, holes));
+        for (const Engine& engine : engines) {
+            if (static_cast<int>(ast.numVariables()) > engine.maxVars) continue;
+            std::ostringstream name;
+            name << "check/" << engine.name << "/php" << pigeons << "x" << holes;
+            runner.run("check", name.str(), "verificação", 1, 0, [&]() {
+                if (!engine.check(ast)) throw std::runtime_error(name.str() + ": casa dos pombos não é tautologia");
+            });
+        }
+    }
+}
+
+// Vazão do modo -a do solver sobre os corpora, processo inteiro
+static void benchBatch(BenchRunner& runner, const BenchConfig& config, const std::vector<Corpus>& corpora) {
+    const char* engines[] = { "bruteforce", "bitslice", "compiled", "sat", "bdd" };
+#ifdef _WIN32
+    const std::string discard = " > NUL";
+#else
+    const std::string discard = " > /dev/null";
+#endif
+    for (const Corpus& corpus : corpora) {
+        for (const char* engine : engines) {
+            const std::string command = config.solver + " " + corpus.path + " -a -s -t 60 -e " + engine + discard;
+            runner.run("batch", "batch/" + corpus.name + "/" + engine, "instância", corpus.count, 0, [&]() {
+                if (std::system(command.c_str()) != 0) {
+                    throw std::runtime_error("Falha ao executar: " + command);
+                }
+            });
+        }
+    }
+}
+
+void printUsage() {
+    std::cout << "Uso: ./bench [opções]" << std::endl;
+    std::cout << "  Mede o parser, a avaliação por atribuição, a verificação completa por motor" << std::endl;
+    std::cout << "  (4 a 26 variáveis) e a vazão do modo -a sobre corpora de seed fixa." << std::endl;
+    std::cout << "Opções:" << std::endl;
+    std::cout << "  --warmup N: Execuções descartadas antes das medidas (padrão: 1)" << std::endl;
+    std::cout << "  --repeat N: Execuções medidas; o resultado traz mediana e p99 (padrão: 5)" << std::endl;
+    std::cout << "  --quick: Corpora menores e até 20 variáveis na verificação" << std::endl;
+    std::cout << "  --filter TEXTO: Só os benchmarks cujo nome contém TEXTO (ex.: check/bitslice)" << std::endl;
+    std::cout << "  --output ARQUIVO: Resultados em JSON (padrão: bench_results.json)" << std::endl;
+    std::cout << "  --solver CAMINHO: Executável usado na vazão do lote (padrão: bin/solver)" << std::endl;
+    std::cout << "  --work-dir DIR: Onde os corpora são gravados (padrão: build/bench)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            config.warmup = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            config.repeat = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--quick") == 0) {
+            config.quick = true;
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            config.filter = argv[++i];
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            config.output = argv[++i];
+        } else if (strcmp(argv[i], "--solver") == 0 && i + 1 < argc) {
+            config.solver = argv[++i];
+        } else if (strcmp(argv[i], "--work-dir") == 0 && i + 1 < argc) {
+            config.workDir = argv[++i];
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            printUsage();
+            return 0;
+        } else {
+            std::cerr << "Opção desconhecida: " << argv[i] << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+    if (config.warmup < 0 || config.repeat < 1) {
+        std::cerr << "Erro: --warmup deve ser >= 0 e --repeat >= 1" << std::endl;
+        return 1;
+    }
+
+    try {
+        // Corpora fixos: os números só são comparáveis entre execuções com os mesmos
+        std::vector<Corpus> corpora = {
+            { "small", 1, config.quick ? 500 : 2000, 3, 8, 6, {}, {}, "" },
+            { "medium", 2, config.quick ? 60 : 200, 12, 18, 8, {}, {}, "" },
+        };
+        makeDirectory(config.workDir);
+        for (Corpus& corpus : corpora) {
+            generateCorpus(corpus);
+            writeCorpus(corpus, config.workDir);
+        }
+
+        std::cout << "=== BENCH (aquecimento " << config.warmup << ", repetições " << config.repeat << ") ==="
+                  << std::endl;
+        BenchRunner runner(config);
+        benchParse(runner, corpora);
+        benchEvaluate(runner, config);
+        benchCheck(runner, config);
+        benchBatch(runner, config, corpora);
+
+        writeJson(config, runner.results);
+        std::cout << "Resultados: " << config.output << " (" << runner.results.size() << " benchmarks)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,49 +1,240 @@
 #include "ast.h"
 #include <iostream>
+#include <sstream>
 #include <algorithm>
+#include <stdexcept>
 
-void ASTNode::collectVariables(std::vector<std::string>& variables) const {
-    if (type == NodeType::VARIABLE) {
-        if (std::find(variables.begin(), variables.end(), value) == variables.end()) {
-            variables.push_back(value);
+uint32_t AST::internVariable(const std::string& name) {
+    auto it = varIds.find(name);
+    if (it != varIds.end()) {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(varNames.size());
+    varNames.push_back(name);
+    varIds[name] = id;
+    return id;
+}
+
+NodeId AST::addVariable(const std::string& name) {
+    return addNode(NodeType::VARIABLE, internVariable(name));
+}
+
+NodeId AST::addNode(NodeType type, NodeId left, NodeId right) {
+    NodeKey key = { type, left, right };
+    if (hashConsing) {
+        auto it = uniqueTable.find(key);
+        if (it != uniqueTable.end()) {
+            return it->second;
         }
     }
-    
-    if (left) {
-        left->collectVariables(variables);
+
+    if (nodes.size() >= INVALID_NODE) {
+        throw std::runtime_error("Fórmula excede o número máximo de nós");
+    }
+
+    ASTNode node;
+    node.type = type;
+    node.left = left;
+    node.right = right;
+    nodes.push_back(node);
+
+    NodeId id = static_cast<NodeId>(nodes.size() - 1);
+    if (hashConsing) {
+        uniqueTable[key] = id;
+    }
+    return id;
+}
+
+void AST::setHashConsing(bool enabled) {
+    hashConsing = enabled;
+    uniqueTable.clear();
+    if (!enabled) return;
+
+    // Nós já existentes entram na tabela; duplicatas antigas continuam válidas
+    for (NodeId id = 0; id < nodes.size(); ++id) {
+        NodeKey key = { nodes[id].type, nodes[id].left, nodes[id].right };
+        uniqueTable.insert(std::make_pair(key, id));
+    }
+}
+
+std::vector<bool> AST::sharedNodes() const {
+    std::vector<uint8_t> parents(nodes.size(), 0);
+    std::vector<bool> shared(nodes.size(), false);
+
+    for (const auto& node : nodes) {
+        if (node.isLeaf()) continue;
+        if (parents[node.left] < 2) parents[node.left]++;
+        if (node.isBinary() && parents[node.right] < 2) parents[node.right]++;
+    }
+    for (NodeId id = 0; id < nodes.size(); ++id) {
+        shared[id] = parents[id] > 1 && !nodes[id].isLeaf();
     }
-    if (right) {
-        right->collectVariables(variables);
+    return shared;
+}
+
+void AST::sortVariables() {
+    std::vector<std::string> sorted = varNames;
+    std::sort(sorted.begin(), sorted.end());
+
+    if (sorted == varNames) return;
+
+    std::vector<uint32_t> remap(varNames.size());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        remap[varIds[sorted[i]]] = static_cast<uint32_t>(i);
+        varIds[sorted[i]] = static_cast<uint32_t>(i);
+    }
+
+    for (auto& node : nodes) {
+        if (node.type == NodeType::VARIABLE) {
+            node.left = remap[node.left];
+        }
+    }
+    varNames = sorted;
+
+    // As chaves das folhas mudaram junto com os IDs
+    if (hashConsing) {
+        setHashConsing(true);
     }
 }
 
-void ASTNode::print(int depth) const {
+AST AST::extract(NodeId subRoot) const {
+    AST out;
+    out.setHashConsing(hashConsing);
+
+    std::vector<bool> reachable(nodes.size(), false);
+    reachable[subRoot] = true;
+    for (NodeId id = subRoot + 1; id-- > 0;) {
+        if (!reachable[id]) continue;
+        if (!nodes[id].isLeaf()) reachable[nodes[id].left] = true;
+        if (nodes[id].isBinary()) reachable[nodes[id].right] = true;
+    }
+
+    std::vector<NodeId> remap(subRoot + 1, INVALID_NODE);
+    for (NodeId id = 0; id <= subRoot; ++id) {
+        if (!reachable[id]) continue;
+        const ASTNode& n = nodes[id];
+        if (n.isLeaf()) {
+            remap[id] = out.addVariable(varNames[n.varId()]);
+        } else if (n.isUnary()) {
+            remap[id] = out.addNode(n.type, remap[n.left]);
+        } else {
+            remap[id] = out.addNode(n.type, remap[n.left], remap[n.right]);
+        }
+    }
+    out.setRoot(remap[subRoot]);
+    return out;
+}
+
+void AST::loadNodes(const ASTNode* data, size_t count, NodeId rootId, const std::vector<std::string>& names) {
+    nodes.assign(data, data + count);
+    varNames = names;
+    varIds.clear();
+    for (size_t i = 0; i < varNames.size(); ++i) {
+        varIds[varNames[i]] = static_cast<uint32_t>(i);
+    }
+    root = rootId;
+    hashConsing = false;
+    uniqueTable.clear();
+}
+
+void AST::collectVariables(std::vector<std::string>& variables) const {
+    if (empty()) return;
+
+    std::vector<bool> seen(varNames.size(), false);
+    for (const auto& name : variables) {
+        auto it = varIds.find(name);
+        if (it != varIds.end()) {
+            seen[it->second] = true;
+        }
+    }
+    collectVariables(root, variables, seen);
+}
+
+void AST::collectVariables(NodeId id, std::vector<std::string>& variables, std::vector<bool>& seen) const {
+    const ASTNode& n = nodes[id];
+
+    if (n.type == NodeType::VARIABLE) {
+        if (!seen[n.varId()]) {
+            seen[n.varId()] = true;
+            variables.push_back(varNames[n.varId()]);
+        }
+        return;
+    }
+
+    collectVariables(n.left, variables, seen);
+    if (n.isBinary()) {
+        collectVariables(n.right, variables, seen);
+    }
+}
+
+void AST::print(std::ostream& out, int depth) const {
+    if (!empty()) {
+        print(out, root, depth);
+    }
+}
+
+void AST::print(std::ostream& out, NodeId id, int depth) const {
     for (int i = 0; i < depth; ++i) {
-        std::cout << "  ";
+        out << "  ";
     }
-    
-    switch (type) {
+
+    const ASTNode& n = nodes[id];
+    switch (n.type) {
         case NodeType::VARIABLE:
-            std::cout << "VAR: " << value << std::endl;
+            out << "VAR: " << varNames[n.varId()] << std::endl;
             break;
         case NodeType::NOT:
-            std::cout << "NOT" << std::endl;
+            out << "NOT" << std::endl;
             break;
         case NodeType::AND:
-            std::cout << "AND" << std::endl;
+            out << "AND" << std::endl;
             break;
         case NodeType::OR:
-            std::cout << "OR" << std::endl;
+            out << "OR" << std::endl;
             break;
         case NodeType::IMPLIES:
-            std::cout << "IMPLIES" << std::endl;
+            out << "IMPLIES" << std::endl;
             break;
     }
-    
-    if (left) {
-        left->print(depth + 1);
+
+    if (!n.isLeaf()) {
+        print(out, n.left, depth + 1);
+    }
+    if (n.isBinary()) {
+        print(out, n.right, depth + 1);
+    }
+}
+
+void AST::write(std::ostream& out) const {
+    if (!empty()) {
+        write(out, root);
     }
-    if (right) {
-        right->print(depth + 1);
+}
+
+void AST::write(std::ostream& out, NodeId id) const {
+    const ASTNode& n = nodes[id];
+    switch (n.type) {
+        case NodeType::VARIABLE:
+            out << varNames[n.varId()];
+            return;
+        case NodeType::NOT:
+            out << "¬";
+            write(out, n.left);
+            return;
+        default:
+            break;
     }
+
+    out << "(";
+    write(out, n.left);
+    out << (n.type == NodeType::AND ? " ∧ " : n.type == NodeType::OR ? " ∨ " : " → ");
+    write(out, n.right);
+    out << ")";
+}
+
+std::string AST::toString() const {
+    std::ostringstream out;
+    write(out);
+    return out.str();
 }
\ No newline at end of file
@@ -1,37 +1,124 @@
 #ifndef AST_H
 #define AST_H
 
+#include <cstdint>
+#include <iostream>
 #include <string>
-#include <memory>
+#include <unordered_map>
 #include <vector>
 
-enum class NodeType {
+enum class NodeType : uint8_t {
     VARIABLE,
-    NOT,        
-    AND,       
-    OR,        
-    IMPLIES     
+    NOT,
+    AND,
+    OR,
+    IMPLIES
 };
 
-class ASTNode {
-public:
+typedef uint32_t NodeId;
+const NodeId INVALID_NODE = 0xFFFFFFFFu;
+
+// Nó compacto (12 bytes): os filhos são índices no arena da AST e, para
+// VARIABLE, left guarda o ID denso da variável
+struct ASTNode {
     NodeType type;
-    std::string value;  
-    std::shared_ptr<ASTNode> left;
-    std::shared_ptr<ASTNode> right;
-    
-    ASTNode(NodeType t) : type(t), left(nullptr), right(nullptr) {}
-    ASTNode(NodeType t, const std::string& val) : type(t), value(val), left(nullptr), right(nullptr) {}
-    
-    bool isLeaf() const { return left == nullptr && right == nullptr; }
+    NodeId left;
+    NodeId right;
+
+    bool isLeaf() const { return type == NodeType::VARIABLE; }
     bool isUnary() const { return type == NodeType::NOT; }
     bool isBinary() const { return type == NodeType::AND || type == NodeType::OR || type == NodeType::IMPLIES; }
-    
+
+    uint32_t varId() const { return left; }
+};
+
+// Arena de nós contígua. Os nós são criados de baixo para cima, então os
+// filhos sempre têm índice menor que o pai e percorrer o vetor em ordem
+// crescente é uma ordem topológica válida.
+class AST {
+private:
+    struct NodeKey {
+        NodeType type;
+        NodeId left;
+        NodeId right;
+
+        bool operator==(const NodeKey& other) const {
+            return type == other.type && left == other.left && right == other.right;
+        }
+    };
+
+    struct NodeKeyHash {
+        size_t operator()(const NodeKey& k) const {
+            uint64_t h = (static_cast<uint64_t>(k.left) << 32) ^ k.right;
+            h ^= static_cast<uint64_t>(k.type) << 61;
+            h *= 0x9E3779B97F4A7C15ULL;
+            return static_cast<size_t>(h ^ (h >> 29));
+        }
+    };
+
+    std::vector<ASTNode> nodes;
+    std::vector<std::string> varNames;
+    std::unordered_map<std::string, uint32_t> varIds;
+    NodeId root;
+
+    // Tabela única: com hash-consing, subárvores estruturalmente iguais
+    // viram um único nó e a AST passa a ser um DAG
+    bool hashConsing;
+    std::unordered_map<NodeKey, NodeId, NodeKeyHash> uniqueTable;
+
+    void collectVariables(NodeId id, std::vector<std::string>& variables, std::vector<bool>& seen) const;
+    void print(std::ostream& out, NodeId id, int depth) const;
+    void write(std::ostream& out, NodeId id) const;
+
+public:
+    AST() : root(INVALID_NODE), hashConsing(false) {}
+
+    void setHashConsing(bool enabled);
+    bool isHashConsing() const { return hashConsing; }
+
+    // Nós internos com mais de um pai no DAG (sempre falso sem hash-consing)
+    std::vector<bool> sharedNodes() const;
+
+    // Retorna o ID denso da variável, criando-o na primeira ocorrência
+    uint32_t internVariable(const std::string& name);
+
+    NodeId addVariable(const std::string& name);
+    NodeId addNode(NodeType type, NodeId left, NodeId right = INVALID_NODE);
+
+    void setRoot(NodeId id) { root = id; }
+    NodeId getRoot() const { return root; }
+    bool empty() const { return root == INVALID_NODE; }
+
+    const ASTNode& node(NodeId id) const { return nodes[id]; }
+    const ASTNode* data() const { return nodes.data(); }
+    size_t size() const { return nodes.size(); }
+    void reserve(size_t count) { nodes.reserve(count); }
+
+    size_t numVariables() const { return varNames.size(); }
+    const std::string& variableName(uint32_t id) const { return varNames[id]; }
+    const std::vector<std::string>& variableNames() const { return varNames; }
+
+    // Renumera os IDs das variáveis em ordem alfabética (ordem da tabela verdade)
+    void sortVariables();
+
+    // Copia a subfórmula de raiz subRoot para uma nova AST que contém só as
+    // variáveis que ela usa (IDs na ordem de aparição; use sortVariables)
+    AST extract(NodeId subRoot) const;
+
+    // Substitui o conteúdo por nós já prontos (em ordem topológica), sem
+    // passar por addNode. A tabela única não é montada: para acrescentar nós
+    // com compartilhamento depois, chame setHashConsing(true).
+    void loadNodes(const ASTNode* data, size_t count, NodeId rootId, const std::vector<std::string>& names);
+
+    size_t memoryUsage() const { return nodes.capacity() * sizeof(ASTNode); }
 
     void collectVariables(std::vector<std::string>& variables) const;
-    
 
-    void print(int depth = 0) const;
+    void print(std::ostream& out = std::cout, int depth = 0) const;
+
+    // Fórmula na sintaxe do parser, com parênteses em todo conectivo binário
+    void write(std::ostream& out) const;
+    std::string toString() const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,228 @@
+#include "binary_instances.h"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+const char BinaryInstances::MAGIC[8] = { 'T', 'C', 'B', 'I', 'N', '\0', '\0', '\0' };
+const uint32_t BinaryInstances::VERSION;
+
+bool BinaryInstances::isBinary(const MappedFile& file) {
+    return file.size() >= sizeof(Header) && std::memcmp(file.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+BinaryInstanceWriter::BinaryInstanceWriter(const std::string& filename)
+    : file(filename, std::ios::binary | std::ios::trunc), path(filename), position(0), finished(false) {
+    if (!file.is_open()) {
+        throw std::runtime_error("Não foi possível criar o arquivo: " + filename);
+    }
+
+    // O cabeçalho definitivo é gravado por finish()
+    BinaryInstances::Header placeholder;
+    std::memset(&placeholder, 0, sizeof(placeholder));
+    file.write(reinterpret_cast<const char*>(&placeholder), sizeof(placeholder));
+    position = sizeof(placeholder);
+}
+
+BinaryInstanceWriter::~BinaryInstanceWriter() {
+    if (!finished && file.is_open()) {
+        // Arquivo incompleto: não deixa um .bin com cabeçalho zerado para trás
+        file.close();
+        std::remove(path.c_str());
+    }
+}
+
+BinaryInstances::StringRef BinaryInstanceWriter::intern(const std::string& text) {
+    auto it = interned.find(text);
+    if (it != interned.end()) {
+        return it->second;
+    }
+    if (strings.size() + text.size() > 0xFFFFFFFFull) {
+        throw std::runtime_error("Tabela de strings excede 4 GB");
+    }
+    BinaryInstances::StringRef ref = { static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(text.size()) };
+    strings += text;
+    interned[text] = ref;
+    return ref;
+}
+
+void BinaryInstanceWriter::add(const std::string& id, const std::string& type, const AST& formula) {
+    BinaryInstances::Entry entry;
+    std::memset(&entry, 0, sizeof(entry));
+    entry.nodesOffset = position;
+    entry.varsOffset = varRefs.size();  // Relativo; ajustado em finish()
+    entry.numNodes = static_cast<uint32_t>(formula.size());
+    entry.root = formula.getRoot();
+    entry.numVars = static_cast<uint32_t>(formula.numVariables());
+    entry.id = intern(id);
+    entry.type = intern(type);
+
+    // Bytes de preenchimento zerados, para que o arquivo seja determinístico
+    std::vector<ASTNode> nodes(formula.size());
+    std::memset(nodes.data(), 0, nodes.size() * sizeof(ASTNode));
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const ASTNode& n = formula.node(static_cast<NodeId>(i));
+        nodes[i].type = n.type;
+        nodes[i].left = n.left;
+        nodes[i].right = n.right;
+    }
+    file.write(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(ASTNode));
+    position += nodes.size() * sizeof(ASTNode);
+
+    for (const auto& name : formula.variableNames()) {
+        varRefs.push_back(intern(name));
+    }
+    directory.push_back(entry);
+}
+
+void BinaryInstanceWriter::finish() {
+    const uint64_t varsBase = position;
+    file.write(reinterpret_cast<const char*>(varRefs.data()), varRefs.size() * sizeof(BinaryInstances::StringRef));
+    position += varRefs.size() * sizeof(BinaryInstances::StringRef);
+
+    BinaryInstances::Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BinaryInstances::MAGIC, sizeof(header.magic));
+    header.version = BinaryInstances::VERSION;
+    header.nodeSize = sizeof(ASTNode);
+    header.numInstances = directory.size();
+    header.stringsOffset = position;
+    header.stringsSize = strings.size();
+    file.write(strings.data(), strings.size());
+    position += strings.size();
+
+    // O diretório começa alinhado a 8 bytes
+    static const char padding[8] = { 0 };
+    const uint64_t pad = (8 - position % 8) % 8;
+    file.write(padding, pad);
+    position += pad;
+
+    header.directoryOffset = position;
+    for (auto& entry : directory) {
+        entry.varsOffset = varsBase + entry.varsOffset * sizeof(BinaryInstances::StringRef);
+    }
+    file.write(reinterpret_cast<const char*>(directory.data()), directory.size() * sizeof(BinaryInstances::Entry));
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Erro ao gravar o arquivo: " + path);
+    }
+    finished = true;
+}
+
+namespace {
+
+// count itens de itemSize bytes a partir de offset cabem em limit bytes,
+// sem estourar a aritmética de 64 bits
+bool fits(uint64_t offset, uint64_t count, uint64_t itemSize, uint64_t limit) {
+    return offset <= limit && count <= (limit - offset) / itemSize;
+}
+
+void corrupted(const std::string& detail) {
+    throw std::runtime_error("Arquivo binário corrompido: " + detail);
+}
+
+} // namespace
+
+BinaryInstanceFile::BinaryInstanceFile(const std::string& filename) : file(filename) {
+    if (!BinaryInstances::isBinary(file)) {
+        throw std::runtime_error("Arquivo binário de instâncias inválido: " + filename);
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.version != BinaryInstances::VERSION || header.nodeSize != sizeof(ASTNode)) {
+        throw std::runtime_error("Versão do arquivo binário não suportada: " + filename);
+    }
+    if (!fits(header.directoryOffset, header.numInstances, sizeof(BinaryInstances::Entry), file.size()) ||
+        !fits(header.stringsOffset, header.stringsSize, 1, file.size())) {
+        throw std::runtime_error("Arquivo binário truncado: " + filename);
+    }
+}
+
+bool BinaryInstanceFile::validString(const BinaryInstances::StringRef& ref) const {
+    return fits(ref.offset, ref.length, 1, header.stringsSize);
+}
+
+TextSpan BinaryInstanceFile::text(const BinaryInstances::StringRef& ref) const {
+    return TextSpan(file.data() + header.stringsOffset + ref.offset, ref.length);
+}
+
+// Os intervalos da entrada são conferidos aqui, antes de qualquer leitura
+// através dela; o conteúdo dos nós é conferido por load()
+BinaryInstances::Entry BinaryInstanceFile::entry(uint64_t index) const {
+    if (index >= header.numInstances) {
+        throw std::runtime_error("Instância fora do arquivo binário: " + std::to_string(index));
+    }
+    BinaryInstances::Entry e;
+    std::memcpy(&e, file.data() + header.directoryOffset + index * sizeof(BinaryInstances::Entry), sizeof(e));
+
+    const std::string where = "entrada " + std::to_string(index);
+    if (!fits(e.nodesOffset, e.numNodes, sizeof(ASTNode), file.size()) || e.nodesOffset % alignof(ASTNode) != 0) {
+        corrupted(where + ": nós fora do arquivo");
+    }
+    if (!fits(e.varsOffset, e.numVars, sizeof(BinaryInstances::StringRef), file.size())) {
+        corrupted(where + ": variáveis fora do arquivo");
+    }
+    if (!validString(e.id) || !validString(e.type)) {
+        corrupted(where + ": ID ou tipo fora da tabela de strings");
+    }
+    if (e.numNodes > 0 && e.root >= e.numNodes) {
+        corrupted(where + ": raiz " + std::to_string(e.root) + " fora dos " + std::to_string(e.numNodes) + " nós");
+    }
+    return e;
+}
+
+void BinaryInstanceFile::load(const BinaryInstances::Entry& e, AST& ast) const {
+    const std::string where = "instância " + id(e).str();
+
+    std::vector<std::string> names(e.numVars);
+    for (uint32_t v = 0; v < e.numVars; ++v) {
+        BinaryInstances::StringRef ref;
+        std::memcpy(&ref, file.data() + e.varsOffset + v * sizeof(ref), sizeof(ref));
+        if (!validString(ref)) {
+            corrupted(where + ": nome da variável " + std::to_string(v) + " fora da tabela de strings");
+        }
+        names[v] = text(ref).str();
+    }
+
+    // Os nós começam em posição múltipla de 4 dentro de um mapeamento
+    // alinhado à página, então podem ser lidos no lugar
+    const ASTNode* nodes = reinterpret_cast<const ASTNode*>(file.data() + e.nodesOffset);
+
+    // Os motores confiam na ordem topológica e nos IDs densos das variáveis
+    for (uint32_t i = 0; i < e.numNodes; ++i) {
+        const ASTNode& n = nodes[i];
+        bool valid;
+        switch (n.type) {
+            case NodeType::VARIABLE:
+                valid = n.left < e.numVars;
+                break;
+            case NodeType::NOT:
+                valid = n.left < i;
+                break;
+            case NodeType::AND:
+            case NodeType::OR:
+            case NodeType::IMPLIES:
+                valid = n.left < i && n.right < i;
+                break;
+            default:
+                valid = false;
+                break;
+        }
+        if (!valid) {
+            corrupted(where + ": nó " + std::to_string(i) + " inválido");
+        }
+    }
+
+    ast.loadNodes(nodes, e.numNodes, e.numNodes > 0 ? e.root : INVALID_NODE, names);
+}
+
+bool BinaryInstanceFile::find(const std::string& id, uint64_t& index) const {
+    for (uint64_t i = 0; i < header.numInstances; ++i) {
+        if (this->id(entry(i)).equals(id)) {
+            index = i;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,110 @@
+#ifndef BINARY_INSTANCES_H
+#define BINARY_INSTANCES_H
+
+#include "ast.h"
+#include "mapped_file.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Formato binário de instâncias (.bin): as fórmulas já vêm no arena da AST,
+// com os nós em ordem topológica e as subfórmulas repetidas compartilhadas,
+// junto com a tabela de variáveis (em ordem alfabética), o ID e o tipo de
+// cada instância. O solver mapeia o arquivo e copia os nós direto para a
+// AST, sem parse. Layout (inteiros na ordem de bytes da máquina):
+//
+//   Header | nós de todas as instâncias | referências das variáveis |
+//   tabela de strings | diretório (uma Entry por instância)
+class BinaryInstances {
+public:
+    static const char MAGIC[8];
+    static const uint32_t VERSION = 1;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t nodeSize;          // sizeof(ASTNode) de quem gravou
+        uint64_t numInstances;
+        uint64_t directoryOffset;
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+        uint64_t reserved[2];
+    };
+
+    // Trecho da tabela de strings
+    struct StringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct Entry {
+        uint64_t nodesOffset;       // Posição do primeiro nó no arquivo
+        uint64_t varsOffset;        // numVars StringRefs, na ordem dos IDs
+        uint32_t numNodes;
+        uint32_t root;
+        uint32_t numVars;
+        StringRef id;
+        StringRef type;
+        uint32_t reserved;
+    };
+
+    // Verifica o magic no início de um arquivo já mapeado
+    static bool isBinary(const MappedFile& file);
+};
+
+// Grava um arquivo binário instância por instância: os nós vão direto para
+// o disco e só o diretório e as strings (deduplicadas) ficam em memória.
+class BinaryInstanceWriter {
+private:
+    std::ofstream file;
+    std::string path;
+    uint64_t position;
+    std::vector<BinaryInstances::Entry> directory;
+    std::vector<BinaryInstances::StringRef> varRefs;
+    std::string strings;
+    std::unordered_map<std::string, BinaryInstances::StringRef> interned;
+    bool finished;
+
+    BinaryInstances::StringRef intern(const std::string& text);
+
+public:
+    explicit BinaryInstanceWriter(const std::string& filename);
+    ~BinaryInstanceWriter();
+
+    void add(const std::string& id, const std::string& type, const AST& formula);
+
+    // Grava as tabelas e o cabeçalho; sem isso o arquivo fica inválido
+    void finish();
+};
+
+// Leitura de um arquivo binário mapeado em memória
+class BinaryInstanceFile {
+private:
+    MappedFile file;
+    BinaryInstances::Header header;
+
+    TextSpan text(const BinaryInstances::StringRef& ref) const;
+    bool validString(const BinaryInstances::StringRef& ref) const;
+
+public:
+    explicit BinaryInstanceFile(const std::string& filename);
+
+    uint64_t size() const { return header.numInstances; }
+
+    // Lança runtime_error se a entrada aponta para fora do arquivo
+    BinaryInstances::Entry entry(uint64_t index) const;
+    TextSpan id(const BinaryInstances::Entry& e) const { return text(e.id); }
+    TextSpan type(const BinaryInstances::Entry& e) const { return text(e.type); }
+
+    // Copia os nós e as variáveis da instância para ast. Lança runtime_error
+    // se um nó tem tipo inválido, filho que não vem antes dele ou variável
+    // fora da tabela
+    void load(const BinaryInstances::Entry& e, AST& ast) const;
+
+    // Posição da instância com esse ID (a primeira, se houver repetidos)
+    bool find(const std::string& id, uint64_t& index) const;
+};
+
+#endif
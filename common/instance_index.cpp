@@ -0,0 +1,258 @@
+#include "instance_index.h"
+#include "instance_reader.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <vector>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+static const char INDEX_MAGIC[8] = { 'T', 'C', 'I', 'D', 'X', '\0', '\0', '\0' };
+
+const uint32_t InstanceIndex::VERSION;
+const size_t InstanceIndex::SAMPLE_BYTES;
+
+static int processId() {
+#ifdef _WIN32
+    return _getpid();
+#else
+    return static_cast<int>(getpid());
+#endif
+}
+
+InstanceIndex::InstanceIndex() {
+    std::memset(&header, 0, sizeof(header));
+}
+
+// FNV-1a de 64 bits
+uint64_t InstanceIndex::hashBytes(const char* data, size_t size, uint64_t seed) {
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+bool InstanceIndex::fingerprint(const std::string& filename, Header& out) {
+    struct stat info;
+    if (stat(filename.c_str(), &info) != 0) {
+        return false;
+    }
+    out.fileSize = static_cast<uint64_t>(info.st_size);
+    out.fileTime = static_cast<int64_t>(info.st_mtime);
+
+    // Amostras do início e do fim: pegam edições que preservam tamanho e data
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::vector<char> sample(static_cast<size_t>(std::min<uint64_t>(out.fileSize, SAMPLE_BYTES)));
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    file.read(sample.data(), sample.size());
+    hash = hashBytes(sample.data(), static_cast<size_t>(file.gcount()), hash);
+    if (out.fileSize > SAMPLE_BYTES) {
+        file.seekg(static_cast<std::streamoff>(out.fileSize - sample.size()));
+        file.read(sample.data(), sample.size());
+        hash = hashBytes(sample.data(), static_cast<size_t>(file.gcount()), hash);
+    }
+    out.sampleHash = hash;
+    return true;
+}
+
+uint8_t InstanceIndex::typeCode(const std::string& type) {
+    if (type == "TAUTOLOGY") return TYPE_TAUTOLOGY;
+    if (type == "CONTRADICTION") return TYPE_CONTRADICTION;
+    if (type == "RANDOM") return TYPE_RANDOM;
+    return TYPE_OTHER;
+}
+
+InstanceIndex::Entry InstanceIndex::slot(uint64_t i) const {
+    Entry entry;
+    std::memcpy(&entry, mapping->data() + sizeof(Header) + i * sizeof(Entry), sizeof(Entry));
+    return entry;
+}
+
+bool InstanceIndex::load(const std::string& filename) {
+    mapping.reset();
+    sourceFile = filename;
+
+    std::unique_ptr<MappedFile> index;
+    try {
+        index.reset(new MappedFile(indexPath(filename)));
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+    if (index->size() < sizeof(Header)) {
+        return false;
+    }
+
+    Header stored;
+    std::memcpy(&stored, index->data(), sizeof(Header));
+    Header current;
+    if (std::memcmp(stored.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 || stored.version != VERSION ||
+        stored.entrySize != sizeof(Entry) || !fingerprint(filename, current) ||
+        stored.fileSize != current.fileSize || stored.fileTime != current.fileTime ||
+        stored.sampleHash != current.sampleHash) {
+        return false;
+    }
+    if (stored.numSlots == 0 || (stored.numSlots & (stored.numSlots - 1)) != 0 ||
+        index->size() != sizeof(Header) + stored.numSlots * sizeof(Entry)) {
+        return false;
+    }
+
+    header = stored;
+    mapping = std::move(index);
+    return true;
+}
+
+void InstanceIndex::build(const std::string& filename) {
+    mapping.reset();
+    sourceFile = filename;
+
+    Header fresh;
+    std::memset(&fresh, 0, sizeof(fresh));
+    std::memcpy(fresh.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    fresh.version = VERSION;
+    fresh.entrySize = sizeof(Entry);
+    if (!fingerprint(filename, fresh)) {
+        throw std::runtime_error("Não foi possível abrir o arquivo: " + filename);
+    }
+
+    std::vector<Entry> entries;
+    {
+        InstanceReader reader(filename);
+        InstanceRecord record;
+        while (reader.next(record)) {
+            Entry entry;
+            std::memset(&entry, 0, sizeof(entry));
+            entry.idHash = hashBytes(record.id.data, record.id.size, 0xCBF29CE484222325ULL);
+            entry.offset = record.offset;
+            entry.length = static_cast<uint32_t>(record.length);
+            entry.numVars = record.numVars;
+            entry.type = typeCode(record.type.str());
+            entries.push_back(entry);
+        }
+    }
+
+    // Ocupação de no máximo 50%
+    uint64_t numSlots = 16;
+    while (numSlots < entries.size() * 2) numSlots <<= 1;
+    std::vector<Entry> table(static_cast<size_t>(numSlots));
+    std::memset(table.data(), 0, table.size() * sizeof(Entry));
+    const uint64_t mask = numSlots - 1;
+
+    // Inserção em ordem de arquivo: o primeiro de IDs repetidos fica na
+    // frente da sequência de sondagem e é o encontrado pela busca
+    for (const Entry& entry : entries) {
+        uint64_t i = entry.idHash & mask;
+        while (table[i].length != 0) i = (i + 1) & mask;
+        table[i] = entry;
+    }
+
+    fresh.numInstances = entries.size();
+    fresh.numSlots = numSlots;
+
+    // Grava em um arquivo temporário e renomeia, para que um leitor nunca
+    // veja um índice pela metade. O nome do temporário é único por processo
+    // e por chamada: dois processos construindo o mesmo índice não
+    // escrevem no mesmo arquivo.
+    static std::atomic<unsigned> sequence(0);
+    const std::string path = indexPath(filename);
+    const std::string temp = path + ".tmp-" + std::to_string(processId()) + "-" + std::to_string(sequence++);
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Não foi possível criar o arquivo: " + temp);
+        }
+        out.write(reinterpret_cast<const char*>(&fresh), sizeof(fresh));
+        out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(Entry));
+        if (!out) {
+            std::remove(temp.c_str());
+            throw std::runtime_error("Erro ao gravar o índice: " + temp);
+        }
+    }
+#ifdef _WIN32
+    // No Windows rename não substitui um arquivo existente
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        throw std::runtime_error("Não foi possível criar o arquivo: " + path);
+    }
+
+    if (!load(filename)) {
+        throw std::runtime_error("Índice inválido após a gravação: " + path);
+    }
+}
+
+bool InstanceIndex::find(const std::string& id, InstanceData& instance, Entry* found) const {
+    if (!mapping) return false;
+
+    std::ifstream file(sourceFile, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Não foi possível abrir o arquivo: " + sourceFile);
+    }
+
+    const uint64_t hash = hashBytes(id.data(), id.size(), 0xCBF29CE484222325ULL);
+    const uint64_t mask = header.numSlots - 1;
+    std::string line;
+
+    for (uint64_t i = hash & mask;; i = (i + 1) & mask) {
+        Entry entry = slot(i);
+        if (entry.length == 0) return false;
+        if (entry.idHash != hash) continue;
+
+        line.resize(entry.length);
+        file.seekg(static_cast<std::streamoff>(entry.offset));
+        file.read(&line[0], entry.length);
+        if (!file) {
+            throw std::runtime_error("Índice desatualizado: " + indexPath(sourceFile));
+        }
+
+        InstanceRecord record;
+        if (parseInstanceLine(TextSpan(line.data(), line.size()).trim(), record) && record.id.equals(id)) {
+            instance = record.toData();
+            if (found != nullptr) *found = entry;
+            return true;
+        }
+    }
+}
+
+InstanceData InstanceIndex::lookup(const std::string& filename, const std::string& instanceId) {
+    InstanceIndex index;
+    bool ready = index.load(filename);
+    if (!ready) {
+        try {
+            index.build(filename);
+            ready = true;
+        } catch (const std::runtime_error&) {
+            ready = false;
+        }
+    }
+
+    InstanceData instance;
+    if (ready) {
+        if (index.find(instanceId, instance)) {
+            return instance;
+        }
+    } else {
+        // Sem índice: busca linear, parando na primeira ocorrência
+        InstanceReader reader(filename);
+        InstanceRecord record;
+        while (reader.next(record)) {
+            if (record.id.equals(instanceId)) {
+                return record.toData();
+            }
+        }
+    }
+
+    throw std::runtime_error("Instância não encontrada: " + instanceId);
+}
@@ -0,0 +1,80 @@
+#ifndef INSTANCE_INDEX_H
+#define INSTANCE_INDEX_H
+
+#include "mapped_file.h"
+#include "utils.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Índice de um arquivo de instâncias, gravado ao lado dele em <arquivo>.idx.
+// É uma tabela hash em disco (endereçamento aberto) de ID para a posição da
+// linha no arquivo, com o número de variáveis e o tipo de cada instância.
+// O índice é mapeado em memória, então uma busca lê só as posições sondadas
+// e depois a linha apontada (um seek e o parse de uma linha).
+//
+// O cabeçalho guarda tamanho, data de modificação e um hash de amostras do
+// início e do fim do arquivo; se algum deles não bate, o índice é ignorado
+// e reconstruído. IDs repetidos apontam para a primeira ocorrência, como na
+// busca linear. Os inteiros são gravados na ordem de bytes da máquina.
+class InstanceIndex {
+public:
+    enum TypeCode { TYPE_OTHER = 0, TYPE_TAUTOLOGY = 1, TYPE_CONTRADICTION = 2, TYPE_RANDOM = 3 };
+
+    struct Entry {
+        uint64_t idHash;
+        uint64_t offset;        // Início da linha no arquivo de instâncias
+        uint32_t length;        // 0 marca uma posição vazia da tabela
+        int32_t numVars;
+        uint8_t type;
+        uint8_t reserved[7];
+    };
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t entrySize;
+        uint64_t fileSize;
+        int64_t fileTime;
+        uint64_t sampleHash;
+        uint64_t numInstances;
+        uint64_t numSlots;      // Potência de 2
+    };
+
+    std::string sourceFile;
+    Header header;
+    std::unique_ptr<MappedFile> mapping;
+
+    static const uint32_t VERSION = 1;
+    static const size_t SAMPLE_BYTES = 64 * 1024;
+
+    static uint64_t hashBytes(const char* data, size_t size, uint64_t seed);
+    static bool fingerprint(const std::string& filename, Header& out);
+    Entry slot(uint64_t i) const;
+
+public:
+    InstanceIndex();
+
+    static std::string indexPath(const std::string& filename) { return filename + ".idx"; }
+
+    // Abre o índice de filename; false se ele não existe ou está desatualizado
+    bool load(const std::string& filename);
+
+    // Percorre o arquivo, grava o índice e o deixa aberto; lança
+    // runtime_error se não conseguir gravar
+    void build(const std::string& filename);
+
+    // Procura o ID e lê a linha correspondente no arquivo de instâncias
+    bool find(const std::string& id, InstanceData& instance, Entry* entry = nullptr) const;
+
+    uint64_t size() const { return header.numInstances; }
+
+    static uint8_t typeCode(const std::string& type);
+
+    // Busca pelo índice, construindo-o se preciso. Se o índice não puder ser
+    // gravado (diretório somente leitura, por exemplo), cai na busca linear.
+    static InstanceData lookup(const std::string& filename, const std::string& instanceId);
+};
+
+#endif
@@ -0,0 +1,61 @@
+#include "instance_reader.h"
+#include <cstring>
+
+InstanceData InstanceRecord::toData() const {
+    InstanceData data;
+    data.id = id.str();
+    data.formula = formula.str();
+    data.type = type.str();
+    data.numVars = numVars;
+    return data;
+}
+
+bool parseInstanceLine(TextSpan line, InstanceRecord& record) {
+    TextSpan fields[4];
+    size_t start = 0;
+    for (int f = 0; f < 4; ++f) {
+        if (start >= line.size) return false;
+        const char* bar = static_cast<const char*>(std::memchr(line.data + start, '|', line.size - start));
+        size_t end = bar ? static_cast<size_t>(bar - line.data) : line.size;
+        if (!bar && f < 3) return false;
+        fields[f] = TextSpan(line.data + start, end - start).trim();
+        start = end + 1;
+    }
+
+    record.id = fields[0];
+    record.formula = fields[1];
+    record.type = fields[2];
+    record.numVars = std::stoi(fields[3].str());
+    return true;
+}
+
+InstanceReader::InstanceReader(const std::string& filename) : file(filename), pos(0) {}
+
+bool InstanceReader::isInstancesFile() const {
+    const char* end = static_cast<const char*>(std::memchr(file.data(), '\n', file.size()));
+    size_t length = end ? static_cast<size_t>(end - file.data()) : file.size();
+    return TextSpan(file.data(), length).contains("# Arquivo de Instâncias");
+}
+
+bool InstanceReader::next(InstanceRecord& record) {
+    const char* data = file.data();
+    const size_t size = file.size();
+
+    while (pos < size) {
+        const size_t begin = pos;
+        const char* newline = static_cast<const char*>(std::memchr(data + begin, '\n', size - begin));
+        const size_t end = newline ? static_cast<size_t>(newline - data) : size;
+        pos = newline ? end + 1 : size;
+
+        TextSpan line = TextSpan(data + begin, end - begin).trim();
+        if (line.empty() || line.data[0] == '#') {
+            continue;
+        }
+        if (parseInstanceLine(line, record)) {
+            record.offset = begin;
+            record.length = end - begin;
+            return true;
+        }
+    }
+    return false;
+}
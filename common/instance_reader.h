@@ -0,0 +1,47 @@
+#ifndef INSTANCE_READER_H
+#define INSTANCE_READER_H
+
+#include "mapped_file.h"
+#include "utils.h"
+#include <cstdint>
+#include <string>
+
+// Linha INSTANCE_ID|FORMULA|TYPE|NUM_VARS de um arquivo de instâncias. Os
+// campos apontam para o arquivo mapeado e valem enquanto o leitor existir.
+struct InstanceRecord {
+    TextSpan id;
+    TextSpan formula;
+    TextSpan type;
+    int numVars;
+    uint64_t offset;    // Posição da linha no arquivo
+    uint64_t length;    // Tamanho da linha, sem a quebra
+
+    InstanceData toData() const;
+};
+
+// Percorre um arquivo de instâncias mapeado em memória, devolvendo uma
+// linha por vez sem copiar o texto. Linhas vazias e comentários (#) são
+// ignorados, assim como linhas com menos de 4 campos.
+class InstanceReader {
+private:
+    MappedFile file;
+    size_t pos;
+
+public:
+    explicit InstanceReader(const std::string& filename);
+
+    // A primeira linha identifica um arquivo gerado pelo gerador
+    bool isInstancesFile() const;
+
+    // Lê a próxima instância; false no fim do arquivo
+    bool next(InstanceRecord& record);
+
+    void rewind() { pos = 0; }
+
+    const MappedFile& mapping() const { return file; }
+};
+
+// Lê uma linha no formato de instância; false se ela não tem 4 campos
+bool parseInstanceLine(TextSpan line, InstanceRecord& record);
+
+#endif
@@ -0,0 +1,85 @@
+#include "mapped_file.h"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+TextSpan TextSpan::trim() const {
+    size_t start = 0;
+    size_t end = size;
+    while (start < end && isSpace(data[start])) start++;
+    while (end > start && isSpace(data[end - 1])) end--;
+    return TextSpan(data + start, end - start);
+}
+
+bool TextSpan::contains(const char* text) const {
+    const size_t n = std::strlen(text);
+    if (n == 0) return true;
+    for (size_t i = 0; i + n <= size; ++i) {
+        if (std::memcmp(data + i, text, n) == 0) return true;
+    }
+    return false;
+}
+
+#ifndef _WIN32
+
+MappedFile::MappedFile(const std::string& filename) : bytes(nullptr), length(0) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Não foi possível abrir o arquivo: " + filename);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("Não foi possível ler o arquivo: " + filename);
+    }
+
+    length = static_cast<size_t>(info.st_size);
+    if (length > 0) {
+        void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Não foi possível mapear o arquivo: " + filename);
+        }
+        // A leitura é de ponta a ponta: o kernel pode ler adiantado
+        madvise(address, length, MADV_SEQUENTIAL);
+        bytes = static_cast<const char*>(address);
+    }
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (bytes != nullptr && length > 0) {
+        munmap(const_cast<char*>(bytes), length);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filename) : bytes(nullptr), length(0) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Não foi possível abrir o arquivo: " + filename);
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    buffer = content.str();
+    bytes = buffer.data();
+    length = buffer.size();
+}
+
+MappedFile::~MappedFile() {}
+
+#endif
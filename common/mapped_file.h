@@ -0,0 +1,46 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Trecho de texto que aponta para dentro de um buffer existente, sem cópia
+// (o equivalente a um std::string_view em C++11)
+struct TextSpan {
+    const char* data;
+    size_t size;
+
+    TextSpan() : data(nullptr), size(0) {}
+    TextSpan(const char* begin, size_t length) : data(begin), size(length) {}
+
+    bool empty() const { return size == 0; }
+    std::string str() const { return std::string(data, size); }
+
+    // Sem espaços, tabs e quebras de linha nas pontas
+    TextSpan trim() const;
+    bool contains(const char* text) const;
+    bool equals(const std::string& text) const { return text.size() == size && text.compare(0, size, data, size) == 0; }
+};
+
+// Arquivo somente leitura mapeado em memória. As páginas são carregadas sob
+// demanda pelo sistema operacional, então percorrer um arquivo grande não
+// exige memória proporcional ao tamanho dele. Sem mmap (Windows), o conteúdo
+// é lido para um buffer com a mesma interface.
+class MappedFile {
+private:
+    const char* bytes;
+    size_t length;
+    std::string buffer;     // Usado só quando não há mmap
+
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+#endif
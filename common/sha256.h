@@ -0,0 +1,28 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// SHA-256 (FIPS 180-4) incremental, usado como impressão digital de fórmulas
+class Sha256 {
+private:
+    uint32_t state[8];
+    uint8_t buffer[64];
+    size_t buffered;
+    uint64_t length;
+
+    void compress(const uint8_t* block);
+
+public:
+    Sha256();
+
+    void update(const void* data, size_t size);
+    void update(const std::string& text) { update(text.data(), text.size()); }
+
+    // Finaliza e devolve o resumo em hexadecimal (64 caracteres)
+    std::string hexDigest();
+};
+
+#endif
@@ -1,4 +1,6 @@
 #include "utils.h"
+#include "instance_index.h"
+#include "instance_reader.h"
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -18,46 +20,20 @@ std::string FileUtils::readFormula(const std::string& filename) {
 }
 
 std::vector<InstanceData> FileUtils::readInstances(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Não foi possível abrir o arquivo: " + filename);
-    }
-    
+    InstanceReader reader(filename);
     std::vector<InstanceData> instances;
-    std::string line;
+    InstanceRecord record;
     
-    while (std::getline(file, line)) {
-        line = trim(line);
-
-        if (line.empty() || line[0] == '#') {
-            continue;
-        }
-        
-        auto parts = split(line, '|');
-        if (parts.size() >= 4) {
-            InstanceData instance;
-            instance.id = trim(parts[0]);
-            instance.formula = trim(parts[1]);
-            instance.type = trim(parts[2]);
-            instance.numVars = std::stoi(trim(parts[3]));
-            instances.push_back(instance);
-        }
+    while (reader.next(record)) {
+        instances.push_back(record.toData());
     }
     
-    file.close();
     return instances;
 }
 
 InstanceData FileUtils::readInstanceById(const std::string& filename, const std::string& instanceId) {
-    auto instances = readInstances(filename);
-    
-    for (const auto& instance : instances) {
-        if (instance.id == instanceId) {
-            return instance;
-        }
-    }
-    
-    throw std::runtime_error("Instância não encontrada: " + instanceId);
+    // Busca pelo índice <arquivo>.idx, criado na primeira chamada
+    return InstanceIndex::lookup(filename, instanceId);
 }
 
 void FileUtils::writeFormula(const std::string& filename, const std::string& formula, int numVariables) {
@@ -0,0 +1,97 @@
+#include "../common/binary_instances.h"
+#include "../common/instance_reader.h"
+#include "../solver/parser.h"
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+
+void printUsage() {
+    std::cout << "Uso: ./convert <entrada> <saida>" << std::endl;
+    std::cout << "  Converte um arquivo de instâncias entre texto e binário (.bin)." << std::endl;
+    std::cout << "  A direção é detectada pelo conteúdo da entrada:" << std::endl;
+    std::cout << "    texto   → binário (fórmulas já compiladas para a AST)" << std::endl;
+    std::cout << "    binário → texto   (uma instância por linha, com parênteses completos)" << std::endl;
+}
+
+// Cada fórmula é analisada uma única vez e gravada como AST compartilhada
+size_t textToBinary(const std::string& input, const std::string& output) {
+    InstanceReader reader(input);
+    if (!reader.isInstancesFile()) {
+        throw std::runtime_error("Não é um arquivo de instâncias: " + input);
+    }
+
+    BinaryInstanceWriter writer(output);
+    InstanceRecord record;
+    size_t count = 0;
+    while (reader.next(record)) {
+        const std::string id = record.id.str();
+        AST ast;
+        try {
+            Parser parser(record.formula.str(), true);
+            ast = parser.parse();
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Instância " + id + ": " + e.what());
+        }
+        ast.sortVariables();
+        writer.add(id, record.type.str(), ast);
+        count++;
+    }
+    writer.finish();
+    return count;
+}
+
+size_t binaryToText(const std::string& input, const std::string& output) {
+    BinaryInstanceFile binary(input);
+
+    std::ofstream file(output);
+    if (!file.is_open()) {
+        throw std::runtime_error("Não foi possível criar o arquivo: " + output);
+    }
+
+    file << "# Arquivo de Instâncias de Tautologias Booleanas" << std::endl;
+    file << "# Convertido de: " << input << std::endl;
+    file << "# Formato: INSTANCE_ID|FORMULA|TYPE|NUM_VARS" << std::endl;
+    file << "#" << std::endl;
+
+    AST ast;
+    for (uint64_t i = 0; i < binary.size(); ++i) {
+        BinaryInstances::Entry entry = binary.entry(i);
+        binary.load(entry, ast);
+        file << binary.id(entry).str() << "|";
+        ast.write(file);
+        file << "|" << binary.type(entry).str() << "|" << entry.numVars << std::endl;
+    }
+
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Erro ao gravar o arquivo: " + output);
+    }
+    return binary.size();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+
+    std::string input = argv[1];
+    std::string output = argv[2];
+
+    try {
+        bool fromBinary;
+        {
+            MappedFile file(input);
+            fromBinary = BinaryInstances::isBinary(file);
+        }
+
+        size_t count = fromBinary ? binaryToText(input, output) : textToBinary(input, output);
+        std::cout << "Convertidas " << count << " instâncias: " << input << " → " << output
+                  << (fromBinary ? " (texto)" : " (binário)") << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
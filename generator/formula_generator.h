@@ -0,0 +1,159 @@
+#ifndef FORMULA_GENERATOR_H
+#define FORMULA_GENERATOR_H
+
+#include <cctype>
+#include <random>
+#include <set>
+#include <string>
+
+// Gerador de fórmulas aleatórias usado pelo generator e pelo bench: a mesma
+// semente produz a mesma sequência de fórmulas
+class FormulaGenerator {
+private:
+    std::mt19937 gen;
+    std::uniform_int_distribution<> varDist;
+    std::uniform_int_distribution<> opDist;
+    std::uniform_real_distribution<> probDist;
+    std::uniform_int_distribution<> targetVarsDist;
+    
+    int minVariables;
+    int maxVariables;
+    int maxDepth;
+    
+public:
+    FormulaGenerator(int seed, int minVars, int maxVars, int depth) 
+        : gen(seed), varDist(0, maxVars - 1), opDist(0, 3), probDist(0.0, 1.0),
+          targetVarsDist(minVars, maxVars), minVariables(minVars), maxVariables(maxVars), maxDepth(depth) {}
+    
+    // As 26 primeiras variáveis são a-z; as seguintes, v26, v27, ...
+    static std::string variableName(int index) {
+        if (index < 26) {
+            return std::string(1, static_cast<char>('a' + index));
+        }
+        return "v" + std::to_string(index);
+    }
+    
+    // Identificadores presentes na fórmula (letra ou _, seguida de letras, dígitos ou _)
+    static std::set<std::string> collectVariables(const std::string& formula) {
+        std::set<std::string> names;
+        size_t i = 0;
+        while (i < formula.size()) {
+            if (!std::isalpha(static_cast<unsigned char>(formula[i])) && formula[i] != '_') {
+                i++;
+                continue;
+            }
+            size_t start = i;
+            while (i < formula.size() && (std::isalnum(static_cast<unsigned char>(formula[i])) || formula[i] == '_')) {
+                i++;
+            }
+            names.insert(formula.substr(start, i - start));
+        }
+        return names;
+    }
+    
+    std::string generateVariable() {
+        return variableName(varDist(gen));
+    }
+    
+
+    std::string generateFormulaWithTargetVars(int targetVars, int depth = 0) {
+        if (depth >= maxDepth || probDist(gen) < 0.3) {
+            return variableName(gen() % targetVars);
+        }
+        
+        int op = opDist(gen);
+        
+        switch (op) {
+            case 0: // NOT
+                return "¬" + generateFormulaWithTargetVars(targetVars, depth + 1);
+            case 1: // AND
+                return "(" + generateFormulaWithTargetVars(targetVars, depth + 1) + 
+                       " ∧ " + generateFormulaWithTargetVars(targetVars, depth + 1) + ")";
+            case 2: // OR
+                return "(" + generateFormulaWithTargetVars(targetVars, depth + 1) + 
+                       " ∨ " + generateFormulaWithTargetVars(targetVars, depth + 1) + ")";
+            case 3: // IMPLICAÇÃO
+                return "(" + generateFormulaWithTargetVars(targetVars, depth + 1) + 
+                       " → " + generateFormulaWithTargetVars(targetVars, depth + 1) + ")";
+            default:
+                return variableName(gen() % targetVars);
+        }
+    }
+    
+    // Força o uso de todas as variáveis no range desejado
+    std::string generateFormulaWithAllVars(int targetVars) {
+        std::string formula = generateFormulaWithTargetVars(targetVars);
+        
+        // Verifica quais variáveis estão sendo usadas
+        std::set<std::string> usedVars = collectVariables(formula);
+        
+        // Se não temos todas as variáveis desejadas, força sua inclusão
+        std::set<std::string> missingVars;
+        for (int i = 0; i < targetVars; ++i) {
+            std::string var = variableName(i);
+            if (usedVars.find(var) == usedVars.end()) {
+                missingVars.insert(var);
+            }
+        }
+        
+        // Adiciona variáveis faltantes através de ORs (não afeta tautologias)
+        for (const std::string& missingVar : missingVars) {
+            formula = "(" + formula + " ∨ (" + missingVar + " ∨ ¬" + missingVar + "))";
+        }
+        
+        return formula;
+    }
+    
+    std::string generateFormula(int depth = 0) {
+        int targetVars = targetVarsDist(gen);
+        return generateFormulaWithAllVars(targetVars);
+    }
+    
+    // Gera uma tautologia conhecida com número específico de variáveis
+    std::string generateTautology() {
+        int targetVars = targetVarsDist(gen);
+        
+        // Escolhe um tipo de tautologia base
+        std::string baseTautology;
+        std::string baseVar = variableName(0);
+        
+        switch (opDist(gen) % 3) {
+            case 0:
+                baseTautology = "(" + baseVar + " ∨ ¬" + baseVar + ")";
+                break;
+            case 1:
+                baseTautology = "((" + baseVar + " → " + baseVar + "))";
+                break;
+            case 2:
+                baseTautology = "¬(" + baseVar + " ∧ ¬" + baseVar + ")";
+                break;
+        }
+        
+        // Adiciona as outras variáveis como tautologias neutras
+        for (int i = 1; i < targetVars; ++i) {
+            std::string var = variableName(i);
+            baseTautology = "(" + baseTautology + " ∧ (" + var + " ∨ ¬" + var + "))";
+        }
+        
+        return baseTautology;
+    }
+    
+    // Gera uma contradição conhecida com número específico de variáveis
+    std::string generateContradiction() {
+        int targetVars = targetVarsDist(gen);
+        
+        // Base: contradição simples
+        std::string baseVar = variableName(0);
+        std::string baseContradiction = "(" + baseVar + " ∧ ¬" + baseVar + ")";
+        
+        // Adiciona as outras variáveis como tautologias neutras (não afeta a contradição)
+        for (int i = 1; i < targetVars; ++i) {
+            std::string var = variableName(i);
+            baseContradiction = "(" + baseContradiction + " ∧ (" + var + " ∨ ¬" + var + "))";
+        }
+        
+        return baseContradiction;
+    }
+};
+
+#endif
@@ -1,150 +1,25 @@
 #include "../common/utils.h"
+#include "../common/instance_index.h"
+#include "../common/binary_instances.h"
+#include "../solver/parser.h"
+#include "formula_generator.h"
 #include <iostream>
-#include <random>
 #include <sstream>
 #include <fstream>
 #include <iomanip>
 #include <ctime>
 #include <set>
-
-class FormulaGenerator {
-private:
-    std::mt19937 gen;
-    std::uniform_int_distribution<> varDist;
-    std::uniform_int_distribution<> opDist;
-    std::uniform_real_distribution<> probDist;
-    std::uniform_int_distribution<> targetVarsDist;
-    
-    int minVariables;
-    int maxVariables;
-    int maxDepth;
-    
-public:
-    FormulaGenerator(int seed, int minVars, int maxVars, int depth) 
-        : gen(seed), minVariables(minVars), maxVariables(maxVars), maxDepth(depth),
-          varDist(0, maxVars - 1), opDist(0, 3), probDist(0.0, 1.0),
-          targetVarsDist(minVars, maxVars) {}
-    
-    std::string generateVariable() {
-        char var = 'a' + varDist(gen);
-        return std::string(1, var);
-    }
-    
-
-    std::string generateFormulaWithTargetVars(int targetVars, int depth = 0) {
-        if (depth >= maxDepth || probDist(gen) < 0.3) {
-            char var = 'a' + (gen() % targetVars);
-            return std::string(1, var);
-        }
-        
-        int op = opDist(gen);
-        
-        switch (op) {
-            case 0: // NOT
-                return "¬" + generateFormulaWithTargetVars(targetVars, depth + 1);
-            case 1: // AND
-                return "(" + generateFormulaWithTargetVars(targetVars, depth + 1) + 
-                       " ∧ " + generateFormulaWithTargetVars(targetVars, depth + 1) + ")";
-            case 2: // OR
-                return "(" + generateFormulaWithTargetVars(targetVars, depth + 1) + 
-                       " ∨ " + generateFormulaWithTargetVars(targetVars, depth + 1) + ")";
-            case 3: // IMPLICAÇÃO
-                return "(" + generateFormulaWithTargetVars(targetVars, depth + 1) + 
-                       " → " + generateFormulaWithTargetVars(targetVars, depth + 1) + ")";
-            default:
-                char var = 'a' + (gen() % targetVars);
-                return std::string(1, var);
-        }
-    }
-    
-    // Força o uso de todas as variáveis no range desejado
-    std::string generateFormulaWithAllVars(int targetVars) {
-        std::string formula = generateFormulaWithTargetVars(targetVars);
-        
-        // Verifica quais variáveis estão sendo usadas
-        std::set<char> usedVars;
-        for (char c : formula) {
-            if (c >= 'a' && c <= 'z') {
-                usedVars.insert(c);
-            }
-        }
-        
-        // Se não temos todas as variáveis desejadas, força sua inclusão
-        std::set<char> missingVars;
-        for (int i = 0; i < targetVars; ++i) {
-            char var = 'a' + i;
-            if (usedVars.find(var) == usedVars.end()) {
-                missingVars.insert(var);
-            }
-        }
-        
-        // Adiciona variáveis faltantes através de ORs (não afeta tautologias)
-        for (char missingVar : missingVars) {
-            formula = "(" + formula + " ∨ (" + std::string(1, missingVar) + " ∨ ¬" + std::string(1, missingVar) + "))";
-        }
-        
-        return formula;
-    }
-    
-    std::string generateFormula(int depth = 0) {
-        int targetVars = targetVarsDist(gen);
-        return generateFormulaWithAllVars(targetVars);
-    }
-    
-    // Gera uma tautologia conhecida com número específico de variáveis
-    std::string generateTautology() {
-        int targetVars = targetVarsDist(gen);
-        
-        // Escolhe um tipo de tautologia base
-        std::string baseTautology;
-        char baseVar = 'a';
-        
-        switch (opDist(gen) % 3) {
-            case 0:
-                baseTautology = "(" + std::string(1, baseVar) + " ∨ ¬" + std::string(1, baseVar) + ")";
-                break;
-            case 1:
-                baseTautology = "((" + std::string(1, baseVar) + " → " + std::string(1, baseVar) + "))";
-                break;
-            case 2:
-                baseTautology = "¬(" + std::string(1, baseVar) + " ∧ ¬" + std::string(1, baseVar) + ")";
-                break;
-        }
-        
-        // Adiciona as outras variáveis como tautologias neutras
-        for (int i = 1; i < targetVars; ++i) {
-            char var = 'a' + i;
-            baseTautology = "(" + baseTautology + " ∧ (" + std::string(1, var) + " ∨ ¬" + std::string(1, var) + "))";
-        }
-        
-        return baseTautology;
-    }
-    
-    // Gera uma contradição conhecida com número específico de variáveis
-    std::string generateContradiction() {
-        int targetVars = targetVarsDist(gen);
-        
-        // Base: contradição simples
-        char baseVar = 'a';
-        std::string baseContradiction = "(" + std::string(1, baseVar) + " ∧ ¬" + std::string(1, baseVar) + ")";
-        
-        // Adiciona as outras variáveis como tautologias neutras (não afeta a contradição)
-        for (int i = 1; i < targetVars; ++i) {
-            char var = 'a' + i;
-            baseContradiction = "(" + baseContradiction + " ∧ (" + std::string(1, var) + " ∨ ¬" + std::string(1, var) + "))";
-        }
-        
-        return baseContradiction;
-    }
-};
+#include <memory>
+#include <vector>
 
 void printUsage() {
-    std::cout << "Uso: ./generator <num_instancias> <min_variaveis> <max_variaveis> <profundidade_maxima> [seed]" << std::endl;
+    std::cout << "Uso: ./generator <num_instancias> <min_variaveis> <max_variaveis> <profundidade_maxima> [seed] [--binary]" << std::endl;
     std::cout << "  num_instancias: Número de instâncias a gerar" << std::endl;
-    std::cout << "  min_variaveis: Número mínimo de variáveis diferentes (a-z)" << std::endl;
-    std::cout << "  max_variaveis: Número máximo de variáveis diferentes (a-z)" << std::endl;
+    std::cout << "  min_variaveis: Número mínimo de variáveis diferentes (a-z, depois v26, v27, ...)" << std::endl;
+    std::cout << "  max_variaveis: Número máximo de variáveis diferentes" << std::endl;
     std::cout << "  profundidade_maxima: Profundidade máxima da árvore de sintaxe" << std::endl;
     std::cout << "  seed: Semente para geração aleatória (opcional)" << std::endl;
+    std::cout << "  --binary: Também grava instances_<timestamp>.bin, já compilado para a AST" << std::endl;
     std::cout << std::endl;
     std::cout << "Distribuição de tipos:" << std::endl;
     std::cout << "  70% Tautologias" << std::endl;
@@ -153,21 +28,28 @@ void printUsage() {
 }
 
 int main(int argc, char* argv[]) {
-    if (argc < 5) {
+    // --binary pode aparecer em qualquer posição; o resto é posicional
+    bool writeBinary = false;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--binary") {
+            writeBinary = true;
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    if (args.size() < 4) {
         printUsage();
         return 1;
     }
     
-    int numInstances = std::stoi(argv[1]);
-    int minVars = std::stoi(argv[2]);
-    int maxVars = std::stoi(argv[3]);
-    int maxDepth = std::stoi(argv[4]);
-    int seed = (argc > 5) ? std::stoi(argv[5]) : std::time(nullptr);
-    
-    if (maxVars > 26) {
-        std::cout << "Erro: Máximo de 26 variáveis suportadas (a-z)" << std::endl;
-        return 1;
-    }
+    int numInstances = std::stoi(args[0]);
+    int minVars = std::stoi(args[1]);
+    int maxVars = std::stoi(args[2]);
+    int maxDepth = std::stoi(args[3]);
+    int seed = (args.size() > 4) ? std::stoi(args[4]) : std::time(nullptr);
     
     if (minVars > maxVars) {
         std::cout << "Erro: Número mínimo de variáveis deve ser menor ou igual ao máximo" << std::endl;
@@ -185,6 +67,8 @@ int main(int argc, char* argv[]) {
     std::time_t now = std::time(nullptr);
     std::ostringstream filename;
     filename << "instances_" << now << ".txt";
+    std::ostringstream binaryName;
+    binaryName << "instances_" << now << ".bin";
     
     try {
         std::ofstream file(filename.str());
@@ -201,6 +85,11 @@ int main(int argc, char* argv[]) {
         file << "# Formato: INSTANCE_ID|FORMULA|TYPE|NUM_VARS" << std::endl;
         file << "#" << std::endl;
         
+        std::unique_ptr<BinaryInstanceWriter> binary;
+        if (writeBinary) {
+            binary.reset(new BinaryInstanceWriter(binaryName.str()));
+        }
+        
         //70% tautologias, 20% contradições, 10% aleatórias
         int tautologyCount = (int)(numInstances * 0.7);
         int contradictionCount = (int)(numInstances * 0.2);
@@ -225,12 +114,7 @@ int main(int argc, char* argv[]) {
             }
             
             // Conta variáveis únicas na fórmula
-            std::set<char> uniqueVars;
-            for (char c : formula) {
-                if (c >= 'a' && c <= 'z') {
-                    uniqueVars.insert(c);
-                }
-            }
+            std::set<std::string> uniqueVars = FormulaGenerator::collectVariables(formula);
             
             // Formato: ID|FORMULA|TYPE|NUM_VARS
             file << std::setfill('0') << std::setw(3) << i << "|" 
@@ -238,13 +122,34 @@ int main(int argc, char* argv[]) {
                  << type << "|" 
                  << uniqueVars.size() << std::endl;
             
+            if (binary) {
+                std::ostringstream id;
+                id << std::setfill('0') << std::setw(3) << i;
+                Parser parser(formula, true);
+                AST ast = parser.parse();
+                ast.sortVariables();
+                binary->add(id.str(), type, ast);
+            }
+            
             std::cout << "Instância " << std::setfill('0') << std::setw(3) << i 
                       << ": " << type << " - " << uniqueVars.size() << " vars - " << formula << std::endl;
         }
         
         file.close();
+        if (binary) {
+            binary->finish();
+        }
+        
+        // Índice de IDs para buscas com -i sem percorrer o arquivo
+        InstanceIndex index;
+        index.build(filename.str());
+        
         std::cout << std::endl << "Geração concluída!" << std::endl;
         std::cout << "Arquivo criado: " << filename.str() << std::endl;
+        std::cout << "Índice criado: " << InstanceIndex::indexPath(filename.str()) << std::endl;
+        if (binary) {
+            std::cout << "Arquivo binário criado: " << binaryName.str() << std::endl;
+        }
         std::cout << "Total de instâncias: " << numInstances << std::endl;
         std::cout << "Range de variáveis: " << minVars << " a " << maxVars << std::endl;
         
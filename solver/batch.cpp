@@ -0,0 +1,184 @@
+#include "batch.h"
+#include "parallel.h"
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+OrderedBatch::OrderedBatch(int jobs, size_t reorderWindow)
+    : numJobs(ParallelSweep::resolveThreads(jobs)),
+      window(reorderWindow > 0 ? reorderWindow : 64 * static_cast<size_t>(ParallelSweep::resolveThreads(jobs))) {}
+
+size_t OrderedBatch::run(const Source& source, const Task& task, const Sink& sink) {
+    struct Slot {
+        std::string output;
+        std::exception_ptr error;
+        bool ready;
+
+        Slot() : ready(false) {}
+    };
+
+    // Buffer circular: o item i ocupa slots[i % window]
+    std::vector<Slot> slots(window);
+    std::mutex lock;
+    std::condition_variable readySignal;
+    std::condition_variable windowSignal;
+    size_t next = 0;
+    size_t delivered = 0;
+    bool exhausted = false;
+    bool abort = false;
+    std::exception_ptr sourceError;
+
+    auto worker = [&]() {
+        for (;;) {
+            size_t i;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                windowSignal.wait(guard, [&] { return abort || exhausted || next < delivered + window; });
+                if (abort || exhausted) return;
+
+                bool more;
+                try {
+                    more = source(next);
+                } catch (...) {
+                    sourceError = std::current_exception();
+                    more = false;
+                }
+                if (!more) {
+                    exhausted = true;
+                    windowSignal.notify_all();
+                    readySignal.notify_all();
+                    return;
+                }
+                i = next++;
+            }
+
+            std::ostringstream out;
+            std::exception_ptr error;
+            try {
+                task(i, out);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                Slot& slot = slots[i % window];
+                slot.output = out.str();
+                slot.error = error;
+                slot.ready = true;
+            }
+            readySignal.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < numJobs; ++t) {
+        pool.push_back(std::thread(worker));
+    }
+
+    std::exception_ptr failure;
+    size_t i = 0;
+    for (;; ++i) {
+        std::string output;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            Slot& slot = slots[i % window];
+            readySignal.wait(guard, [&] { return slot.ready || (exhausted && i >= next); });
+            if (!slot.ready) {
+                failure = sourceError;
+                break;
+            }
+            output.swap(slot.output);
+            failure = slot.error;
+            slot.error = std::exception_ptr();
+            slot.ready = false;
+        }
+
+        if (failure) break;
+        sink(i, output);
+
+        // Só depois do sink o slot (e o item do chamador) pode ser reaproveitado
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            delivered = i + 1;
+        }
+        windowSignal.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        abort = true;
+    }
+    windowSignal.notify_all();
+    for (auto& t : pool) {
+        t.join();
+    }
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    return i;
+}
+
+bool EquivalenceGroups::join(const std::string& key, Claim& claim, SharedVerdict& verdict) {
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+        auto found = groups.find(key);
+        if (found == groups.end()) {
+            Group group;
+            group.done = false;
+            groups.insert(std::make_pair(key, group));
+            claim.owner = this;
+            claim.key = key;
+            return true;
+        }
+        if (found->second.done) {
+            verdict = found->second.verdict;
+            recent.splice(recent.begin(), recent, found->second.position);
+            reused++;
+            return false;
+        }
+        // Quem resolve o grupo está em outra thread; se ele desistir, o
+        // grupo some e esta instância passa a ser a primeira
+        ready.wait(guard);
+    }
+}
+
+void EquivalenceGroups::publish(const std::string& key, const SharedVerdict& verdict) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        Group& group = groups[key];
+        if (group.done) {
+            recent.erase(group.position);
+        }
+        group.done = true;
+        group.verdict = verdict;
+        recent.push_front(key);
+        group.position = recent.begin();
+        
+        // Os grupos ainda em andamento não entram na conta: são no máximo
+        // os da janela do lote
+        while (recent.size() > capacity) {
+            groups.erase(recent.back());
+            recent.pop_back();
+        }
+    }
+    ready.notify_all();
+}
+
+void EquivalenceGroups::abandon(const std::string& key) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        groups.erase(key);
+    }
+    ready.notify_all();
+}
+
+void EquivalenceGroups::Claim::publish(const SharedVerdict& verdict) {
+    if (owner == nullptr) return;
+    owner->publish(key, verdict);
+    owner = nullptr;
+}
@@ -0,0 +1,108 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+// Executa tarefas indexadas em um pool de threads e entrega as saídas na
+// ordem de entrada. Os itens são puxados da fonte sob demanda, então a
+// quantidade total não precisa ser conhecida de antemão. Cada tarefa escreve
+// no seu próprio buffer; a thread chamadora repassa os buffers ao sink assim
+// que o próximo da sequência fica pronto. A janela limita quantos itens
+// podem estar em andamento ou à espera de entrega, o que mantém a memória
+// constante.
+class OrderedBatch {
+public:
+    // Prepara o item index; chamada uma vez por item, em ordem e nunca em
+    // paralelo. false indica que não há mais itens.
+    typedef std::function<bool(size_t index)> Source;
+    typedef std::function<void(size_t index, std::ostream& out)> Task;
+    typedef std::function<void(size_t index, const std::string& output)> Sink;
+
+private:
+    int numJobs;
+    size_t window;
+
+public:
+    OrderedBatch(int jobs, size_t reorderWindow = 0);
+
+    // Os itens index e index + windowSize() nunca estão vivos ao mesmo tempo:
+    // o chamador pode guardá-los em um buffer circular desse tamanho
+    size_t windowSize() const { return window; }
+
+    // Uma exceção lançada por uma tarefa é relançada aqui quando a vez dela
+    // chega, depois que as saídas anteriores foram entregues. Retorna o
+    // número de itens processados.
+    size_t run(const Source& source, const Task& task, const Sink& sink);
+};
+
+// Resultado de uma instância, repassado às equivalentes a ela
+struct SharedVerdict {
+    std::string representative;     // ID da instância que resolveu
+    bool timedOut;
+    bool isTautology;
+    std::string models;             // Contagem de --count, se houver
+
+    SharedVerdict() : timedOut(false), isTautology(false) {}
+};
+
+// Grupos de instâncias equivalentes de um lote, pela impressão digital
+// canônica. A primeira instância de cada grupo resolve; as seguintes
+// esperam por ela, se ainda estiver em andamento em outra thread, e
+// reaproveitam o veredito. Só os capacity grupos resolvidos usados há menos
+// tempo são guardados, para que a memória não cresça com o tamanho do
+// arquivo; uma instância de um grupo esquecido é resolvida de novo.
+class EquivalenceGroups {
+public:
+    static const size_t DEFAULT_CAPACITY = 1 << 16;
+
+private:
+    struct Group {
+        bool done;
+        SharedVerdict verdict;
+        std::list<std::string>::iterator position;  // Em recent, se done
+    };
+
+    std::mutex lock;
+    std::condition_variable ready;
+    std::unordered_map<std::string, Group> groups;
+    std::list<std::string> recent;      // Grupos resolvidos, o mais recente na frente
+    size_t capacity;
+
+    void publish(const std::string& key, const SharedVerdict& verdict);
+    void abandon(const std::string& key);
+
+public:
+    // Posse de um grupo. Se for destruída sem publish (uma exceção, por
+    // exemplo), o grupo é liberado e a próxima instância equivalente resolve.
+    class Claim {
+    private:
+        EquivalenceGroups* owner;
+        std::string key;
+
+    public:
+        Claim() : owner(nullptr) {}
+        ~Claim() { if (owner != nullptr) owner->abandon(key); }
+
+        void publish(const SharedVerdict& verdict);
+
+        friend class EquivalenceGroups;
+    };
+
+    explicit EquivalenceGroups(size_t maxGroups = DEFAULT_CAPACITY) : capacity(maxGroups), reused(0) {}
+
+    // true se a instância é a primeira do grupo: claim passa a ser dela e
+    // deve ser publicado. Senão, verdict recebe o resultado do grupo.
+    bool join(const std::string& key, Claim& claim, SharedVerdict& verdict);
+
+    std::atomic<long long> reused;
+};
+
+#endif
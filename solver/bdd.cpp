@@ -0,0 +1,627 @@
+#include "bdd.h"
+#include <algorithm>
+#include <unordered_map>
+
+const BddEdge BddManager::ONE;
+const BddEdge BddManager::ZERO;
+const uint32_t BddManager::TERMINAL_VAR;
+const uint32_t BddManager::FREE_VAR;
+
+static const BddEdge INVALID_EDGE = 0xFFFFFFFFu;
+static const size_t INITIAL_BUCKETS = 16;
+static const size_t INITIAL_CACHE = 1 << 12;
+static const size_t MAX_CACHE = 1 << 22;
+static const size_t MIN_GC_NODES = 1 << 14;
+static const size_t MIN_REORDER_NODES = 1 << 12;
+static const double MAX_GROWTH = 1.2;
+
+BddManager::BddManager(uint32_t variables, size_t maxNodes)
+    : numVars(variables), nodeLimit(maxNodes), gcThreshold(MIN_GC_NODES),
+      reorderThreshold(MIN_REORDER_NODES), autoReorder(false), deadline(nullptr) {
+    Node terminal = { TERMINAL_VAR, ONE, ONE, 0, 1 };
+    nodes.push_back(terminal);
+
+    SubTable empty;
+    empty.buckets.assign(INITIAL_BUCKETS, 0);
+    empty.count = 0;
+    subtables.assign(numVars, empty);
+
+    varLevel.resize(numVars);
+    levelVar.resize(numVars);
+    for (uint32_t v = 0; v < numVars; ++v) {
+        varLevel[v] = v;
+        levelVar[v] = v;
+    }
+
+    cache.resize(INITIAL_CACHE);
+    clearCache();
+}
+
+void BddManager::setOrder(const std::vector<uint32_t>& order) {
+    for (uint32_t l = 0; l < numVars; ++l) {
+        levelVar[l] = order[l];
+        varLevel[order[l]] = l;
+    }
+}
+
+void BddManager::checkTimeout() const {
+    if (deadline != nullptr) {
+        deadline->check();
+    }
+}
+
+void BddManager::clearCache() {
+    CacheEntry invalid = { INVALID_EDGE, INVALID_EDGE, INVALID_EDGE, INVALID_EDGE };
+    std::fill(cache.begin(), cache.end(), invalid);
+}
+
+size_t BddManager::hashPair(BddEdge high, BddEdge low) {
+    uint64_t h = static_cast<uint64_t>(high) * 0x9E3779B97F4A7C15ULL;
+    h ^= static_cast<uint64_t>(low) * 0xC2B2AE3D27D4EB4FULL;
+    return static_cast<size_t>(h ^ (h >> 32));
+}
+
+void BddManager::cofactors(BddEdge e, uint32_t lvl, BddEdge& high, BddEdge& low) const {
+    if (level(e) != lvl) {
+        high = low = e;
+        return;
+    }
+    const Node& n = nodes[edgeNode(e)];
+    high = n.high ^ (e & 1);
+    low = n.low ^ (e & 1);
+}
+
+uint32_t BddManager::allocNode() {
+    if (nodeLimit > 0 && liveNodes() >= nodeLimit) {
+        throw BddLimitExceeded("BDD excedeu o limite de " + std::to_string(nodeLimit) + " nós");
+    }
+
+    uint32_t idx;
+    if (!freeList.empty()) {
+        idx = freeList.back();
+        freeList.pop_back();
+    } else {
+        idx = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(Node());
+    }
+
+    stats.nodesCreated++;
+    stats.peakNodes = std::max(stats.peakNodes, liveNodes());
+    return idx;
+}
+
+void BddManager::insertNode(uint32_t idx) {
+    Node& n = nodes[idx];
+    SubTable& table = subtables[n.var];
+    size_t b = hashPair(n.high, n.low) & (table.buckets.size() - 1);
+    n.next = table.buckets[b];
+    table.buckets[b] = idx;
+    table.count++;
+
+    if (table.count > 2 * table.buckets.size()) {
+        resizeTable(n.var, 2 * table.buckets.size());
+    }
+}
+
+void BddManager::removeNode(uint32_t idx) {
+    const Node& n = nodes[idx];
+    SubTable& table = subtables[n.var];
+    uint32_t* link = &table.buckets[hashPair(n.high, n.low) & (table.buckets.size() - 1)];
+    while (*link != idx) {
+        link = &nodes[*link].next;
+    }
+    *link = n.next;
+    table.count--;
+}
+
+void BddManager::resizeTable(uint32_t var, size_t buckets) {
+    SubTable& table = subtables[var];
+    std::vector<uint32_t> members;
+    members.reserve(table.count);
+    for (uint32_t head : table.buckets) {
+        for (uint32_t i = head; i != 0; i = nodes[i].next) {
+            members.push_back(i);
+        }
+    }
+
+    table.buckets.assign(buckets, 0);
+    for (uint32_t i : members) {
+        size_t b = hashPair(nodes[i].high, nodes[i].low) & (buckets - 1);
+        nodes[i].next = table.buckets[b];
+        table.buckets[b] = i;
+    }
+}
+
+BddEdge BddManager::makeNode(uint32_t var, BddEdge high, BddEdge low) {
+    if (high == low) {
+        return high;
+    }
+    // Forma canônica: a aresta "então" nunca é complementada
+    if (high & 1) {
+        return complement(makeNode(var, complement(high), complement(low)));
+    }
+
+    const SubTable& table = subtables[var];
+    size_t b = hashPair(high, low) & (table.buckets.size() - 1);
+    for (uint32_t i = table.buckets[b]; i != 0; i = nodes[i].next) {
+        if (nodes[i].high == high && nodes[i].low == low) {
+            return i << 1;
+        }
+    }
+
+    uint32_t idx = allocNode();
+    Node& n = nodes[idx];
+    n.var = var;
+    n.high = high;
+    n.low = low;
+    n.ref = 0;
+    nodes[edgeNode(high)].ref++;
+    nodes[edgeNode(low)].ref++;
+    insertNode(idx);
+    return idx << 1;
+}
+
+BddEdge BddManager::variable(uint32_t var) {
+    return makeNode(var, ONE, ZERO);
+}
+
+BddEdge BddManager::ite(BddEdge f, BddEdge g, BddEdge h) {
+    // Casos terminais
+    if (f == ONE) return g;
+    if (f == ZERO) return h;
+    if (g == f) g = ONE;
+    else if (g == complement(f)) g = ZERO;
+    if (h == f) h = ZERO;
+    else if (h == complement(f)) h = ONE;
+    if (g == h) return g;
+    if (g == ONE && h == ZERO) return f;
+    if (g == ZERO && h == ONE) return complement(f);
+
+    // Tripla padrão: f e g regulares, o complemento sai do resultado
+    if (f & 1) {
+        f = complement(f);
+        std::swap(g, h);
+    }
+    BddEdge negate = 0;
+    if (g & 1) {
+        g = complement(g);
+        h = complement(h);
+        negate = 1;
+    }
+
+    stats.iteCalls++;
+    if ((stats.iteCalls & 4095) == 0) {
+        checkTimeout();
+    }
+
+    uint64_t key = static_cast<uint64_t>(hashPair(f, g)) * 0x9E3779B97F4A7C15ULL + h;
+    size_t slot = static_cast<size_t>(key ^ (key >> 29)) & (cache.size() - 1);
+    const CacheEntry& hit = cache[slot];
+    if (hit.f == f && hit.g == g && hit.h == h) {
+        stats.cacheHits++;
+        return hit.result ^ negate;
+    }
+
+    uint32_t top = std::min(level(f), std::min(level(g), level(h)));
+    BddEdge fHigh, fLow, gHigh, gLow, hHigh, hLow;
+    cofactors(f, top, fHigh, fLow);
+    cofactors(g, top, gHigh, gLow);
+    cofactors(h, top, hHigh, hLow);
+
+    BddEdge high = ite(fHigh, gHigh, hHigh);
+    BddEdge low = ite(fLow, gLow, hLow);
+    BddEdge result = makeNode(levelVar[top], high, low);
+
+    CacheEntry entry = { f, g, h, result };
+    cache[slot] = entry;
+    return result ^ negate;
+}
+
+void BddManager::garbageCollect() {
+    stats.gcRuns++;
+
+    // Libera em cascata os nós sem referência
+    std::vector<uint32_t> work;
+    for (uint32_t i = 1; i < nodes.size(); ++i) {
+        if (nodes[i].var != FREE_VAR && nodes[i].ref == 0) {
+            work.push_back(i);
+        }
+    }
+    while (!work.empty()) {
+        uint32_t i = work.back();
+        work.pop_back();
+
+        uint32_t children[2] = { edgeNode(nodes[i].high), edgeNode(nodes[i].low) };
+        for (uint32_t c : children) {
+            if (c != 0 && --nodes[c].ref == 0) {
+                work.push_back(c);
+            }
+        }
+        nodes[i].var = FREE_VAR;
+        freeList.push_back(i);
+    }
+
+    // Reconstrói as tabelas únicas só com os nós vivos
+    for (auto& table : subtables) {
+        std::fill(table.buckets.begin(), table.buckets.end(), 0);
+        table.count = 0;
+    }
+    for (uint32_t i = 1; i < nodes.size(); ++i) {
+        if (nodes[i].var != FREE_VAR) {
+            insertNode(i);
+        }
+    }
+
+    // O cache pode apontar para nós liberados
+    clearCache();
+}
+
+void BddManager::releaseNode(uint32_t idx) {
+    std::vector<uint32_t> work(1, idx);
+    while (!work.empty()) {
+        uint32_t i = work.back();
+        work.pop_back();
+        if (i == 0 || --nodes[i].ref > 0) continue;
+
+        removeNode(i);
+        work.push_back(edgeNode(nodes[i].high));
+        work.push_back(edgeNode(nodes[i].low));
+        nodes[i].var = FREE_VAR;
+        freeList.push_back(i);
+    }
+}
+
+void BddManager::swapLevels(uint32_t lvl) {
+    const uint32_t x = levelVar[lvl];
+    const uint32_t y = levelVar[lvl + 1];
+
+    std::vector<uint32_t> xNodes;
+    xNodes.reserve(subtables[x].count);
+    for (uint32_t head : subtables[x].buckets) {
+        for (uint32_t i = head; i != 0; i = nodes[i].next) {
+            xNodes.push_back(i);
+        }
+    }
+
+    for (uint32_t f : xNodes) {
+        BddEdge f1 = nodes[f].high;
+        BddEdge f0 = nodes[f].low;
+        bool dependsOnY = nodes[edgeNode(f1)].var == y || nodes[edgeNode(f0)].var == y;
+        if (!dependsOnY) {
+            continue; // O nó continua rotulado por x, agora um nível abaixo
+        }
+
+        BddEdge f11, f10, f01, f00;
+        cofactors(f1, lvl + 1, f11, f10);
+        cofactors(f0, lvl + 1, f01, f00);
+
+        // f = y ? (x ? f11 : f01) : (x ? f10 : f00), reescrito no mesmo índice
+        BddEdge high = makeNode(x, f11, f01);
+        nodes[edgeNode(high)].ref++;
+        BddEdge low = makeNode(x, f10, f00);
+        nodes[edgeNode(low)].ref++;
+
+        removeNode(f);
+        nodes[f].var = y;
+        nodes[f].high = high;
+        nodes[f].low = low;
+        insertNode(f);
+
+        releaseNode(edgeNode(f1));
+        releaseNode(edgeNode(f0));
+    }
+
+    levelVar[lvl] = y;
+    levelVar[lvl + 1] = x;
+    varLevel[y] = lvl;
+    varLevel[x] = lvl + 1;
+}
+
+void BddManager::siftVariable(uint32_t var) {
+    const uint32_t start = varLevel[var];
+    size_t best = liveNodes();
+    uint32_t bestLevel = start;
+
+    // Desce até o último nível, parando se o BDD crescer demais
+    while (varLevel[var] + 1 < numVars) {
+        swapLevels(varLevel[var]);
+        if (liveNodes() < best) {
+            best = liveNodes();
+            bestLevel = varLevel[var];
+        } else if (liveNodes() > best * MAX_GROWTH) {
+            break;
+        }
+    }
+
+    // Sobe até o topo; acima da posição inicial vale o mesmo critério
+    while (varLevel[var] > 0) {
+        swapLevels(varLevel[var] - 1);
+        if (liveNodes() < best) {
+            best = liveNodes();
+            bestLevel = varLevel[var];
+        } else if (varLevel[var] < start && liveNodes() > best * MAX_GROWTH) {
+            break;
+        }
+    }
+
+    // Volta para a melhor posição encontrada
+    while (varLevel[var] < bestLevel) {
+        swapLevels(varLevel[var]);
+    }
+    while (varLevel[var] > bestLevel) {
+        swapLevels(varLevel[var] - 1);
+    }
+}
+
+void BddManager::sift() {
+    if (numVars < 2) return;
+
+    // Sem nós mortos, o número de nós vivos mede o tamanho de cada ordem
+    garbageCollect();
+
+    std::vector<uint32_t> vars(numVars);
+    for (uint32_t v = 0; v < numVars; ++v) vars[v] = v;
+    std::sort(vars.begin(), vars.end(), [this](uint32_t a, uint32_t b) {
+        return subtables[a].count > subtables[b].count;
+    });
+
+    for (uint32_t v : vars) {
+        siftVariable(v);
+        checkTimeout();
+    }
+
+    clearCache();
+    stats.reorderings++;
+}
+
+void BddManager::checkpoint() {
+    checkTimeout();
+
+    if (liveNodes() > gcThreshold) {
+        garbageCollect();
+        gcThreshold = std::max(MIN_GC_NODES, 2 * liveNodes());
+        if (nodeLimit > 0) {
+            gcThreshold = std::min(gcThreshold, std::max(nodeLimit - nodeLimit / 8, liveNodes() + liveNodes() / 8));
+        }
+    }
+
+    if (autoReorder && liveNodes() > reorderThreshold) {
+        sift();
+        reorderThreshold = std::max(reorderThreshold, 2 * liveNodes());
+    }
+
+    // O cache cresce junto com o BDD
+    size_t size = cache.size();
+    while (size < liveNodes() && size < MAX_CACHE) {
+        size *= 2;
+    }
+    if (size != cache.size()) {
+        cache.resize(size);
+        clearCache();
+    }
+}
+
+size_t BddManager::nodeCount(BddEdge e) const {
+    std::vector<bool> visited(nodes.size(), false);
+    std::vector<uint32_t> pending(1, edgeNode(e));
+    size_t count = 0;
+    while (!pending.empty()) {
+        uint32_t i = pending.back();
+        pending.pop_back();
+        if (visited[i]) continue;
+        visited[i] = true;
+        count++;
+        if (i != 0) {
+            pending.push_back(edgeNode(nodes[i].high));
+            pending.push_back(edgeNode(nodes[i].low));
+        }
+    }
+    return count;
+}
+
+std::vector<bool> BddManager::falsifyingAssignment(BddEdge f) const {
+    std::vector<bool> assignment(numVars, false);
+
+    // Em um BDD reduzido toda aresta diferente de 1 alcança o terminal 0
+    BddEdge e = f;
+    while (edgeNode(e) != 0) {
+        const Node& n = nodes[edgeNode(e)];
+        BddEdge high = n.high ^ (e & 1);
+        BddEdge low = n.low ^ (e & 1);
+        if (high != ONE) {
+            assignment[n.var] = true;
+            e = high;
+        } else {
+            e = low;
+        }
+    }
+    return assignment;
+}
+
+BigCount BddManager::satCount(BddEdge f) const {
+    // counts[i]: atribuições dos níveis de i para baixo que satisfazem o nó
+    // regular i; uma aresta complementada conta o complemento
+    std::unordered_map<uint32_t, BigCount> counts;
+    auto edgeCount = [&](BddEdge e) {
+        uint32_t lvl = level(e);
+        if (edgeNode(e) == 0) {
+            return BigCount(e == ONE ? 1 : 0);
+        }
+        BigCount count = counts[edgeNode(e)];
+        if (e & 1) {
+            BigCount all = BigCount::powerOfTwo(numVars - lvl);
+            all -= count;
+            return all;
+        }
+        return count;
+    };
+
+    // Pós-ordem iterativa: os filhos de um nó são contados antes dele
+    std::vector<std::pair<uint32_t, bool> > pending;
+    if (edgeNode(f) != 0) pending.push_back(std::make_pair(edgeNode(f), false));
+    while (!pending.empty()) {
+        uint32_t i = pending.back().first;
+        bool expanded = pending.back().second;
+        pending.pop_back();
+        if (counts.count(i)) continue;
+
+        const Node& n = nodes[i];
+        if (!expanded) {
+            pending.push_back(std::make_pair(i, true));
+            if (edgeNode(n.high) != 0 && !counts.count(edgeNode(n.high))) {
+                pending.push_back(std::make_pair(edgeNode(n.high), false));
+            }
+            if (edgeNode(n.low) != 0 && !counts.count(edgeNode(n.low))) {
+                pending.push_back(std::make_pair(edgeNode(n.low), false));
+            }
+            continue;
+        }
+
+        if ((counts.size() & 4095) == 0) {
+            checkTimeout();
+        }
+        // Níveis pulados entre o nó e o filho são livres: cada um dobra a contagem
+        const uint32_t lvl = varLevel[n.var];
+        BigCount count = edgeCount(n.high).shiftLeft(level(n.high) - lvl - 1);
+        count += edgeCount(n.low).shiftLeft(level(n.low) - lvl - 1);
+        counts[i] = count;
+    }
+
+    return edgeCount(f).shiftLeft(level(f));
+}
+
+void BddEvaluator::setOrdering(const std::string& heuristic) {
+    if (heuristic != "appearance" && heuristic != "alpha" && heuristic != "sift") {
+        throw std::runtime_error("Ordenação de BDD desconhecida: " + heuristic);
+    }
+    ordering = heuristic;
+}
+
+std::vector<uint32_t> BddEvaluator::variableOrder(const AST& formula) const {
+    const uint32_t numVars = static_cast<uint32_t>(formula.numVariables());
+    std::vector<uint32_t> order;
+    order.reserve(numVars);
+
+    if (ordering == "alpha") {
+        // IDs já estão em ordem alfabética
+        for (uint32_t v = 0; v < numVars; ++v) order.push_back(v);
+        return order;
+    }
+
+    std::unordered_map<std::string, uint32_t> ids;
+    for (uint32_t v = 0; v < numVars; ++v) {
+        ids[formula.variableName(v)] = v;
+    }
+
+    std::vector<std::string> names;
+    formula.collectVariables(names);
+    std::vector<bool> placed(numVars, false);
+    for (const auto& name : names) {
+        uint32_t v = ids[name];
+        order.push_back(v);
+        placed[v] = true;
+    }
+    for (uint32_t v = 0; v < numVars; ++v) {
+        if (!placed[v]) order.push_back(v);
+    }
+    return order;
+}
+
+BddEdge BddEvaluator::build(BddManager& manager, const AST& formula) {
+    manager.setDeadline(deadline);
+    manager.setOrder(variableOrder(formula));
+    manager.setAutoReorder(ordering == "sift");
+
+    // Quantos pais alcançáveis ainda vão consumir o BDD de cada nó
+    const size_t size = formula.size();
+    std::vector<bool> reachable(size, false);
+    std::vector<uint32_t> uses(size, 0);
+    reachable[formula.getRoot()] = true;
+    for (NodeId id = static_cast<NodeId>(size); id-- > 0;) {
+        if (!reachable[id]) continue;
+        const ASTNode& node = formula.node(id);
+        if (!node.isLeaf()) {
+            reachable[node.left] = true;
+            uses[node.left]++;
+        }
+        if (node.isBinary()) {
+            reachable[node.right] = true;
+            uses[node.right]++;
+        }
+    }
+
+    std::vector<BddEdge> bdds(size, BddManager::ZERO);
+    auto consume = [&](NodeId child) {
+        if (--uses[child] == 0) {
+            manager.deref(bdds[child]);
+        }
+    };
+
+    for (NodeId id = 0; id < size; ++id) {
+        if (!reachable[id]) continue;
+        const ASTNode& node = formula.node(id);
+
+        BddEdge result = BddManager::ZERO;
+        switch (node.type) {
+            case NodeType::VARIABLE:
+                result = manager.variable(node.varId());
+                break;
+            case NodeType::NOT:
+                result = manager.bddNot(bdds[node.left]);
+                break;
+            case NodeType::AND:
+                result = manager.bddAnd(bdds[node.left], bdds[node.right]);
+                break;
+            case NodeType::OR:
+                result = manager.bddOr(bdds[node.left], bdds[node.right]);
+                break;
+            case NodeType::IMPLIES:
+                result = manager.bddImplies(bdds[node.left], bdds[node.right]);
+                break;
+        }
+
+        manager.ref(result);
+        bdds[id] = result;
+        if (!node.isLeaf()) consume(node.left);
+        if (node.isBinary()) consume(node.right);
+
+        manager.checkpoint();
+    }
+
+    BddEdge root = bdds[formula.getRoot()];
+    bddSize = manager.nodeCount(root);
+    stats = manager.stats;
+    metrics.evaluations = stats.iteCalls;
+    metrics.stackOperations = stats.nodesCreated;
+    metrics.maxStackSize = stats.peakNodes;
+    return root;
+}
+
+bool BddEvaluator::isTautology(const AST& formula) {
+    resetMetrics();
+    if (formula.empty()) return false;
+
+    BddManager manager(static_cast<uint32_t>(formula.numVariables()), nodeLimit);
+    BddEdge root = build(manager, formula);
+
+    if (root == BddManager::ONE) {
+        return true;
+    }
+    model = manager.falsifyingAssignment(root);
+    return false;
+}
+
+BigCount BddEvaluator::countModels(const AST& formula) {
+    resetMetrics();
+    if (formula.empty()) return BigCount();
+
+    BddManager manager(static_cast<uint32_t>(formula.numVariables()), nodeLimit);
+    return manager.satCount(build(manager, formula));
+}
+
+void BddEvaluator::resetMetrics() {
+    metrics = Evaluator::Metrics();
+    stats = BddManager::Stats();
+    bddSize = 0;
+    model.clear();
+}
@@ -0,0 +1,183 @@
+#ifndef BDD_H
+#define BDD_H
+
+#include "../common/ast.h"
+#include "evaluator.h"
+#include "deadline.h"
+#include "bigcount.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Aresta para um nó do BDD: índice do nó << 1 | bit de complemento
+typedef uint32_t BddEdge;
+
+// Lançada quando o número de nós vivos atinge o limite configurado
+class BddLimitExceeded : public std::runtime_error {
+public:
+    explicit BddLimitExceeded(const std::string& message) : std::runtime_error(message) {}
+};
+
+// Pacote de BDDs reduzidos e ordenados (ROBDD) com arestas complementadas:
+// há um único terminal (1) e ¬f é a mesma aresta com o bit de complemento
+// trocado. A aresta "então" de um nó nunca é complementada, o que mantém a
+// representação canônica. Cada variável tem sua própria tabela única, o que
+// permite trocar níveis adjacentes no lugar durante o sifting.
+//
+// Os contadores de referência contam pais (nós) e referências externas. Nós
+// com contador zero continuam nas tabelas até a próxima coleta de lixo e podem
+// ser reaproveitados pelo ITE; durante a reordenação eles são liberados na hora.
+class BddManager {
+public:
+    static const BddEdge ONE = 0;
+    static const BddEdge ZERO = 1;
+
+    struct Stats {
+        long long iteCalls;
+        long long cacheHits;
+        long long nodesCreated;
+        long long gcRuns;
+        long long reorderings;
+        size_t peakNodes;
+
+        Stats() : iteCalls(0), cacheHits(0), nodesCreated(0), gcRuns(0), reorderings(0), peakNodes(0) {}
+    };
+
+private:
+    static const uint32_t TERMINAL_VAR = 0xFFFFFFFFu;
+    static const uint32_t FREE_VAR = 0xFFFFFFFEu;
+
+    struct Node {
+        uint32_t var;
+        BddEdge high;
+        BddEdge low;
+        uint32_t next;      // Próximo nó no balde da tabela única (0 = fim)
+        uint32_t ref;
+    };
+
+    struct CacheEntry {
+        BddEdge f, g, h;
+        BddEdge result;
+    };
+
+    struct SubTable {
+        std::vector<uint32_t> buckets;
+        size_t count;
+    };
+
+    uint32_t numVars;
+    std::vector<Node> nodes;                 // Nó 0 é o terminal
+    std::vector<uint32_t> freeList;
+    std::vector<SubTable> subtables;         // Uma tabela única por variável
+    std::vector<CacheEntry> cache;           // Cache de ITE com mapeamento direto
+    std::vector<uint32_t> varLevel;
+    std::vector<uint32_t> levelVar;
+
+    size_t nodeLimit;
+    size_t gcThreshold;
+    size_t reorderThreshold;
+    bool autoReorder;
+
+    const Deadline* deadline;
+
+    static uint32_t edgeNode(BddEdge e) { return e >> 1; }
+    static BddEdge complement(BddEdge e) { return e ^ 1; }
+    uint32_t level(BddEdge e) const {
+        uint32_t v = nodes[edgeNode(e)].var;
+        return v == TERMINAL_VAR ? numVars : varLevel[v];
+    }
+    // Cofatores de e em relação à variável do nível lvl
+    void cofactors(BddEdge e, uint32_t lvl, BddEdge& high, BddEdge& low) const;
+
+    static size_t hashPair(BddEdge high, BddEdge low);
+    BddEdge makeNode(uint32_t var, BddEdge high, BddEdge low);
+    uint32_t allocNode();
+    void insertNode(uint32_t idx);
+    void removeNode(uint32_t idx);
+    void resizeTable(uint32_t var, size_t buckets);
+    // Decrementa a referência e libera imediatamente os nós que ficam órfãos
+    void releaseNode(uint32_t idx);
+
+    void checkTimeout() const;
+    void clearCache();
+
+    // Troca as variáveis dos níveis lvl e lvl + 1 sem invalidar arestas
+    void swapLevels(uint32_t lvl);
+    void siftVariable(uint32_t var);
+
+public:
+    BddManager(uint32_t variables, size_t maxNodes = 0);
+
+    // Define a ordem (nível 0 no topo); só pode ser chamada antes de criar nós
+    void setOrder(const std::vector<uint32_t>& order);
+    void setAutoReorder(bool enabled) { autoReorder = enabled; }
+    void setDeadline(const Deadline* limit) { deadline = limit; }
+
+    BddEdge variable(uint32_t var);
+    BddEdge ite(BddEdge f, BddEdge g, BddEdge h);
+    BddEdge bddNot(BddEdge f) const { return complement(f); }
+    BddEdge bddAnd(BddEdge f, BddEdge g) { return ite(f, g, ZERO); }
+    BddEdge bddOr(BddEdge f, BddEdge g) { return ite(f, ONE, g); }
+    BddEdge bddImplies(BddEdge f, BddEdge g) { return ite(f, g, ONE); }
+
+    // Referências externas: arestas sem referência podem ser coletadas
+    void ref(BddEdge e) { nodes[edgeNode(e)].ref++; }
+    void deref(BddEdge e) { nodes[edgeNode(e)].ref--; }
+
+    // Ponto seguro entre operações: coleta lixo e reordena se necessário
+    void checkpoint();
+    void garbageCollect();
+    void sift();
+
+    size_t liveNodes() const { return nodes.size() - 1 - freeList.size(); }
+    size_t nodeCount(BddEdge e) const;
+    const std::vector<uint32_t>& order() const { return levelVar; }
+
+    // Um caminho até o terminal 0: atribuição (por variável) que torna f falsa
+    std::vector<bool> falsifyingAssignment(BddEdge f) const;
+
+    // Número de atribuições das numVars variáveis que tornam f verdadeira
+    BigCount satCount(BddEdge f) const;
+
+    Stats stats;
+};
+
+// Constrói o BDD da fórmula de baixo para cima na AST; a fórmula é tautologia
+// se e somente se a raiz é o terminal 1.
+class BddEvaluator {
+private:
+    const Deadline* deadline;
+    std::string ordering;
+    size_t nodeLimit;
+    std::vector<bool> model;
+
+    std::vector<uint32_t> variableOrder(const AST& formula) const;
+
+    // Constrói o BDD da fórmula; a aresta devolvida tem uma referência externa
+    BddEdge build(BddManager& manager, const AST& formula);
+
+public:
+    BddEvaluator(const Deadline* limit = nullptr)
+        : deadline(limit), ordering("appearance"), nodeLimit(0), bddSize(0) {}
+
+    // appearance: ordem de aparição em profundidade; alpha: ordem alfabética;
+    // sift: aparição seguida de sifting dinâmico
+    void setOrdering(const std::string& heuristic);
+    void setNodeLimit(size_t limit) { nodeLimit = limit; }
+
+    bool isTautology(const AST& formula);
+    const std::vector<bool>& counterexample() const { return model; }
+
+    // Número de atribuições que satisfazem a fórmula, contado sobre o BDD
+    BigCount countModels(const AST& formula);
+
+    // evaluations conta chamadas de ITE, stackOperations nós criados e
+    // maxStackSize o pico de nós vivos
+    Evaluator::Metrics metrics;
+    BddManager::Stats stats;
+    size_t bddSize;
+    void resetMetrics();
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "bigcount.h"
+#include <cmath>
+
+BigCount::BigCount(uint64_t value) {
+    while (value != 0) {
+        limbs.push_back(static_cast<uint32_t>(value));
+        value >>= 32;
+    }
+}
+
+void BigCount::trim() {
+    while (!limbs.empty() && limbs.back() == 0) {
+        limbs.pop_back();
+    }
+}
+
+BigCount BigCount::powerOfTwo(uint32_t exponent) {
+    BigCount result(1);
+    return result.shiftLeft(exponent);
+}
+
+BigCount& BigCount::operator+=(const BigCount& other) {
+    if (limbs.size() < other.limbs.size()) {
+        limbs.resize(other.limbs.size(), 0);
+    }
+    uint64_t carry = 0;
+    for (size_t i = 0; i < limbs.size(); ++i) {
+        uint64_t sum = static_cast<uint64_t>(limbs[i]) + carry;
+        if (i < other.limbs.size()) sum += other.limbs[i];
+        limbs[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+        if (carry == 0 && i >= other.limbs.size()) break;
+    }
+    if (carry != 0) {
+        limbs.push_back(static_cast<uint32_t>(carry));
+    }
+    return *this;
+}
+
+BigCount& BigCount::operator-=(const BigCount& other) {
+    int64_t borrow = 0;
+    for (size_t i = 0; i < limbs.size(); ++i) {
+        int64_t diff = static_cast<int64_t>(limbs[i]) - borrow;
+        if (i < other.limbs.size()) diff -= other.limbs[i];
+        borrow = diff < 0 ? 1 : 0;
+        limbs[i] = static_cast<uint32_t>(diff + (borrow << 32));
+        if (borrow == 0 && i >= other.limbs.size()) break;
+    }
+    trim();
+    return *this;
+}
+
+BigCount& BigCount::shiftLeft(uint32_t bits) {
+    if (limbs.empty() || bits == 0) return *this;
+
+    const uint32_t words = bits / 32;
+    const uint32_t rest = bits % 32;
+    if (rest != 0) {
+        uint32_t carry = 0;
+        for (size_t i = 0; i < limbs.size(); ++i) {
+            uint32_t next = limbs[i] >> (32 - rest);
+            limbs[i] = (limbs[i] << rest) | carry;
+            carry = next;
+        }
+        if (carry != 0) {
+            limbs.push_back(carry);
+        }
+    }
+    limbs.insert(limbs.begin(), words, 0);
+    return *this;
+}
+
+double BigCount::ratio(uint32_t bits) const {
+    double result = 0.0;
+    for (size_t i = 0; i < limbs.size(); ++i) {
+        result += std::ldexp(static_cast<double>(limbs[i]), static_cast<int>(32 * i) - static_cast<int>(bits));
+    }
+    return result;
+}
+
+std::string BigCount::toString() const {
+    if (limbs.empty()) return "0";
+
+    // Divisões sucessivas por 10^9, nove dígitos decimais por vez
+    std::vector<uint32_t> value(limbs);
+    std::vector<uint32_t> chunks;
+    while (!value.empty()) {
+        uint64_t remainder = 0;
+        for (size_t i = value.size(); i-- > 0;) {
+            uint64_t current = (remainder << 32) | value[i];
+            value[i] = static_cast<uint32_t>(current / 1000000000u);
+            remainder = current % 1000000000u;
+        }
+        chunks.push_back(static_cast<uint32_t>(remainder));
+        while (!value.empty() && value.back() == 0) {
+            value.pop_back();
+        }
+    }
+
+    std::string result = std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        std::string digits = std::to_string(chunks[i]);
+        result += std::string(9 - digits.size(), '0') + digits;
+    }
+    return result;
+}
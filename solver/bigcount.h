@@ -0,0 +1,38 @@
+#ifndef BIGCOUNT_H
+#define BIGCOUNT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Inteiro sem sinal de precisão arbitrária para contagem de modelos: uma
+// fórmula com n variáveis tem até 2^n atribuições satisfatórias, e n passa
+// facilmente de 64. Só tem as operações que a contagem usa.
+class BigCount {
+private:
+    std::vector<uint32_t> limbs;    // Base 2^32, menos significativo primeiro
+
+    void trim();
+
+public:
+    BigCount(uint64_t value = 0);
+
+    static BigCount powerOfTwo(uint32_t exponent);
+
+    BigCount& operator+=(const BigCount& other);
+    // Supõe *this >= other
+    BigCount& operator-=(const BigCount& other);
+    // Multiplica por 2^bits
+    BigCount& shiftLeft(uint32_t bits);
+
+    bool operator==(const BigCount& other) const { return limbs == other.limbs; }
+    bool operator!=(const BigCount& other) const { return limbs != other.limbs; }
+    bool isZero() const { return limbs.empty(); }
+
+    // Valor / 2^bits como double, sem estourar para contagens grandes
+    double ratio(uint32_t bits) const;
+
+    std::string toString() const;
+};
+
+#endif
@@ -0,0 +1,251 @@
+#include "bitslice.h"
+#include "parallel.h"
+#include "perf_counters.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+// Máscaras de projeção: o bit k da máscara p vale o bit p de k
+static const uint64_t PROJECTION_MASKS[BitSliceEvaluator::LANE_BITS] = {
+    0xAAAAAAAAAAAAAAAAULL,
+    0xCCCCCCCCCCCCCCCCULL,
+    0xF0F0F0F0F0F0F0F0ULL,
+    0xFF00FF00FF00FF00ULL,
+    0xFFFF0000FFFF0000ULL,
+    0xFFFFFFFF00000000ULL
+};
+
+// Verifica o timeout a cada 1024 palavras (65536 atribuições)
+static const uint64_t TIMEOUT_CHECK_INTERVAL = 1024;
+
+void BitSliceEvaluator::compile(const AST& ast) {
+    // Marca os nós alcançáveis a partir da raiz
+    std::vector<int> slotOf(ast.size(), -1);
+    std::vector<NodeId> pending(1, ast.getRoot());
+    while (!pending.empty()) {
+        NodeId id = pending.back();
+        pending.pop_back();
+        if (slotOf[id] >= 0) continue;
+        slotOf[id] = 0;
+
+        const ASTNode& node = ast.node(id);
+        if (!node.isLeaf()) pending.push_back(node.left);
+        if (node.isBinary()) pending.push_back(node.right);
+    }
+
+    // A ordem do arena já é topológica: um slot por nó, filhos antes dos pais
+    program.clear();
+    for (NodeId id = 0; id < ast.size(); ++id) {
+        if (slotOf[id] < 0) continue;
+
+        const ASTNode& node = ast.node(id);
+        BitSliceInstruction inst;
+        inst.type = node.type;
+        inst.left = node.isLeaf() ? static_cast<int>(node.varId()) : slotOf[node.left];
+        inst.right = node.isBinary() ? slotOf[node.right] : -1;
+
+        slotOf[id] = static_cast<int>(program.size());
+        program.push_back(inst);
+    }
+}
+
+void BitSliceEvaluator::initWorkspace(Workspace& ws) const {
+    const uint64_t words = activeKernel->words;
+    ws.slots.assign(program.size() * words, 0);
+    ws.varWords.assign(numVars * words, 0);
+
+    for (int j = 0; j < numVars; ++j) {
+        int bit = numVars - 1 - j;
+        if (bit < LANE_BITS) {
+            for (uint64_t w = 0; w < words; ++w) {
+                ws.varWords[j * words + w] = PROJECTION_MASKS[bit];
+            }
+        }
+    }
+}
+
+bool BitSliceEvaluator::sweepBlocks(Workspace& ws, uint64_t begin, uint64_t end, Evaluator::Metrics& m,
+                                    const std::atomic<bool>* stop, uint64_t* models) const {
+    const SimdKernel& k = *activeKernel;
+    const uint64_t words = k.words;
+    const int n = numVars;
+    const size_t resultBase = (program.size() - 1) * words;
+
+    for (uint64_t b = begin; b < end; ++b) {
+        if (stop && stop->load(std::memory_order_relaxed)) {
+            return true;
+        }
+
+        // Variáveis altas: constantes dentro de cada palavra, dadas pelo contador
+        for (int j = 0; j < n - LANE_BITS; ++j) {
+            int shift = n - 1 - j - LANE_BITS;
+            for (uint64_t w = 0; w < words; ++w) {
+                ws.varWords[j * words + w] = (((b * words + w) >> shift) & 1) ? ~0ULL : 0ULL;
+            }
+        }
+
+        m.stackOperations += program.size() * words;
+        if (useJit) {
+            // Uma palavra por bloco; os slots servem de área de derramamento
+            uint64_t result = jit.run(ws.varWords.data(), ws.slots.data());
+            if (models != nullptr) {
+                *models += __builtin_popcountll(result & validMask);
+                m.evaluations += lanesPerWord;
+                continue;
+            }
+            uint64_t falsified = ~result & validMask;
+            if (falsified) {
+                m.evaluations += __builtin_ctzll(falsified) + 1;
+                return false;
+            }
+            m.evaluations += lanesPerWord;
+            continue;
+        }
+
+        k.run(program.data(), program.size(), ws.varWords.data(), ws.slots.data());
+
+        if (models != nullptr) {
+            for (uint64_t w = 0; w < words; ++w) {
+                *models += __builtin_popcountll(ws.slots[resultBase + w] & validMask);
+            }
+            m.evaluations += lanesPerWord * words;
+            continue;
+        }
+
+        for (uint64_t w = 0; w < words; ++w) {
+            uint64_t falsified = ~ws.slots[resultBase + w] & validMask;
+            if (falsified) {
+                m.evaluations += __builtin_ctzll(falsified) + 1;
+                return false;
+            }
+            m.evaluations += lanesPerWord;
+        }
+    }
+
+    return true;
+}
+
+uint64_t BitSliceEvaluator::prepare(const AST& ast) {
+    PhaseScope phase(SolverPhase::COMPILE);
+    numVars = static_cast<int>(ast.numVariables());
+    compile(ast);
+
+    // Com menos de 6 variáveis só as 2^n primeiras posições são válidas
+    validMask = ~0ULL;
+    lanesPerWord = 64;
+    if (numVars < LANE_BITS) {
+        lanesPerWord = 1ULL << numVars;
+        validMask = (1ULL << lanesPerWord) - 1;
+    }
+    uint64_t totalWords = (numVars > LANE_BITS) ? (1ULL << (numVars - LANE_BITS)) : 1;
+
+    // Espaços pequenos demais para um bloco inteiro usam o kernel escalar
+    activeKernel = (totalWords >= static_cast<uint64_t>(kernel->words)) ? kernel : &SimdDispatch::scalar();
+
+    // O código nativo avalia uma palavra por chamada, com o layout do kernel escalar
+    useJit = false;
+    if (jitEnabled && totalWords >= JIT_MIN_WORDS && JitProgram::supported()) {
+        auto start = std::chrono::steady_clock::now();
+        useJit = jit.compile(program);
+        metrics.compileTime = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        if (useJit) {
+            activeKernel = &SimdDispatch::scalar();
+        }
+    }
+    return totalWords / activeKernel->words;
+}
+
+bool BitSliceEvaluator::isTautology(const AST& ast) {
+    resetMetrics();
+    if (ast.empty()) return false;
+
+    const uint64_t totalBlocks = prepare(ast);
+    const uint64_t words = activeKernel->words;
+
+    if (numThreads != 1) {
+        ParallelSweep sweep(numThreads, std::max<uint64_t>(TIMEOUT_CHECK_INTERVAL / words, 1));
+        std::vector<Workspace> workspaces(ParallelSweep::resolveThreads(numThreads));
+        for (auto& ws : workspaces) {
+            initWorkspace(ws);
+        }
+
+        bool result = sweep.run(totalBlocks, [&](int id, uint64_t begin, uint64_t end, Evaluator::Metrics& m) {
+            return sweepBlocks(workspaces[id], begin, end, m, sweep.stopFlag());
+        }, deadline);
+
+        const long long compileTime = metrics.compileTime;
+        metrics = sweep.metrics;
+        metrics.maxStackSize = program.size();
+        metrics.compileTime = compileTime;
+        return result;
+    }
+
+    Workspace ws;
+    initWorkspace(ws);
+    metrics.maxStackSize = program.size();
+
+    const uint64_t checkInterval = std::max<uint64_t>(TIMEOUT_CHECK_INTERVAL / words, 1);
+
+    for (uint64_t b = 0; b < totalBlocks; b += checkInterval) {
+        if (deadline != nullptr && b > 0) {
+            deadline->check();
+        }
+
+        if (!sweepBlocks(ws, b, std::min(totalBlocks, b + checkInterval), metrics, nullptr)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint64_t BitSliceEvaluator::countModels(const AST& ast) {
+    resetMetrics();
+    if (ast.empty()) return 0;
+    if (ast.numVariables() >= 64) {
+        throw std::runtime_error("Contagem bit-sliced limitada a 63 variáveis");
+    }
+
+    const uint64_t totalBlocks = prepare(ast);
+    const uint64_t checkInterval = std::max<uint64_t>(TIMEOUT_CHECK_INTERVAL / activeKernel->words, 1);
+
+    if (numThreads != 1) {
+        ParallelSweep sweep(numThreads, checkInterval);
+        const int threads = ParallelSweep::resolveThreads(numThreads);
+        std::vector<Workspace> workspaces(threads);
+        std::vector<uint64_t> counts(threads, 0);
+        for (auto& ws : workspaces) {
+            initWorkspace(ws);
+        }
+
+        sweep.run(totalBlocks, [&](int id, uint64_t begin, uint64_t end, Evaluator::Metrics& m) {
+            return sweepBlocks(workspaces[id], begin, end, m, sweep.stopFlag(), &counts[id]);
+        }, deadline);
+
+        const long long compileTime = metrics.compileTime;
+        metrics = sweep.metrics;
+        metrics.maxStackSize = program.size();
+        metrics.compileTime = compileTime;
+        uint64_t total = 0;
+        for (uint64_t c : counts) total += c;
+        return total;
+    }
+
+    Workspace ws;
+    initWorkspace(ws);
+    metrics.maxStackSize = program.size();
+
+    uint64_t total = 0;
+    for (uint64_t b = 0; b < totalBlocks; b += checkInterval) {
+        if (deadline != nullptr && b > 0) {
+            deadline->check();
+        }
+        sweepBlocks(ws, b, std::min(totalBlocks, b + checkInterval), metrics, nullptr, &total);
+    }
+    return total;
+}
+
+void BitSliceEvaluator::resetMetrics() {
+    metrics = Evaluator::Metrics();
+}
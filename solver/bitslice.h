@@ -0,0 +1,89 @@
+#ifndef BITSLICE_H
+#define BITSLICE_H
+
+#include "../common/ast.h"
+#include "evaluator.h"
+#include "simd.h"
+#include "jit.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Avaliador bit-sliced: cada bit de uma palavra de 64 bits corresponde a uma
+// atribuição, de modo que uma passada pelo programa avalia 64 linhas da tabela
+// verdade de uma vez. As 6 variáveis menos significativas viram máscaras de
+// projeção constantes e as demais são derivadas do contador de palavras.
+// Blocos de 4 ou 8 palavras são avaliados pelos kernels AVX2/AVX-512.
+// Em varreduras longas o programa é compilado para código nativo (JitProgram)
+// e cada palavra é avaliada sem despacho; sem suporte, volta aos kernels.
+class BitSliceEvaluator {
+private:
+    // Buffers de trabalho de uma thread
+    struct Workspace {
+        std::vector<uint64_t> slots;
+        std::vector<uint64_t> varWords;
+    };
+
+    std::vector<BitSliceInstruction> program;
+    const SimdKernel* kernel;
+    const Deadline* deadline;
+    int numThreads;
+    bool jitEnabled;
+    JitProgram jit;
+
+    // Parâmetros da varredura atual
+    const SimdKernel* activeKernel;
+    int numVars;
+    uint64_t validMask;
+    uint64_t lanesPerWord;
+    bool useJit;
+
+    void compile(const AST& ast);
+    void initWorkspace(Workspace& ws) const;
+
+    // Compila a fórmula, escolhe o kernel e devolve o número de blocos
+    uint64_t prepare(const AST& ast);
+
+    // Avalia os blocos [begin, end); false se algum falsificar a fórmula.
+    // Com models, soma as atribuições satisfatórias e varre todos os blocos.
+    bool sweepBlocks(Workspace& ws, uint64_t begin, uint64_t end, Evaluator::Metrics& m,
+                     const std::atomic<bool>* stop, uint64_t* models = nullptr) const;
+
+public:
+    static const int LANE_BITS = 6; // 2^6 = 64 atribuições por palavra
+
+    // Varreduras com menos palavras que isso não compensam a compilação
+    static const uint64_t JIT_MIN_WORDS = 1024;
+
+    BitSliceEvaluator(const Deadline* limit = nullptr)
+        : kernel(&SimdDispatch::best()), deadline(limit), numThreads(1), jitEnabled(true),
+          activeKernel(nullptr), numVars(0), validMask(0), lanesPerWord(0), useJit(false) {}
+
+    void setKernel(const SimdKernel& k) { kernel = &k; }
+    const SimdKernel& getKernel() const { return *kernel; }
+
+    // Com mais de uma thread os blocos são divididos por ParallelSweep (0 = todos os núcleos)
+    void setThreads(int threads) { numThreads = threads; }
+
+    // false (--no-jit) mantém os kernels interpretados
+    void setJit(bool enabled) { jitEnabled = enabled; }
+
+    // Se a última varredura rodou em código nativo, e com quantos bytes
+    bool usedJit() const { return useJit; }
+    size_t jitCodeSize() const { return jit.size(); }
+
+    // A variável de ID 0 é o bit mais significativo da tabela verdade
+    bool isTautology(const AST& ast);
+
+    // Número de atribuições que satisfazem a fórmula (popcount de cada
+    // palavra); exige menos de 64 variáveis
+    uint64_t countModels(const AST& ast);
+
+    // evaluations conta atribuições testadas, stackOperations as instruções
+    // executadas (por palavra), maxStackSize o número de slots do programa e
+    // compileTime o tempo gasto gerando código nativo
+    Evaluator::Metrics metrics;
+    void resetMetrics();
+};
+
+#endif
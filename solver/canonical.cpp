@@ -0,0 +1,201 @@
+#include "canonical.h"
+#include "../common/sha256.h"
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+static const uint32_t UNNAMED = 0xFFFFFFFFu;
+
+static uint64_t mix(uint64_t h, uint64_t value) {
+    // Passo do splitmix64 sobre a combinação
+    h ^= value + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+    return h ^ (h >> 31);
+}
+
+static bool isChain(NodeType type) {
+    return type == NodeType::AND || type == NodeType::OR;
+}
+
+void Canonicalizer::flatten(const std::vector<bool>& reachable) {
+    const size_t size = formula.size();
+
+    // Cabeça de cadeia: a raiz ou um nó usado por um pai de outro tipo
+    std::vector<bool> head(size, false);
+    head[formula.getRoot()] = true;
+    for (NodeId id = 0; id < size; ++id) {
+        if (!reachable[id]) continue;
+        const ASTNode& node = formula.node(id);
+        if (!node.isLeaf() && formula.node(node.left).type != node.type) head[node.left] = true;
+        if (node.isBinary() && formula.node(node.right).type != node.type) head[node.right] = true;
+        if (node.type == NodeType::IMPLIES) {
+            head[node.left] = true;
+            head[node.right] = true;
+        }
+    }
+
+    operands.assign(size, std::vector<NodeId>());
+    std::vector<NodeId> pending;
+    for (NodeId id = 0; id < size; ++id) {
+        const ASTNode& node = formula.node(id);
+        if (!reachable[id] || !head[id] || !isChain(node.type)) continue;
+
+        pending.assign(1, node.right);
+        pending.push_back(node.left);
+        while (!pending.empty()) {
+            NodeId x = pending.back();
+            pending.pop_back();
+            const ASTNode& child = formula.node(x);
+            if (child.type == node.type) {
+                pending.push_back(child.right);
+                pending.push_back(child.left);
+            } else {
+                operands[id].push_back(x);
+            }
+        }
+    }
+}
+
+void Canonicalizer::hashNodes(const std::vector<bool>& reachable, std::vector<uint64_t>& hashes, bool withNames) {
+    hashes.assign(formula.size(), 0);
+    std::vector<uint64_t> sorted;
+    for (NodeId id = 0; id < formula.size(); ++id) {
+        if (!reachable[id]) continue;
+        const ASTNode& node = formula.node(id);
+        uint64_t h = mix(0, static_cast<uint64_t>(node.type) + 1);
+
+        if (node.isLeaf()) {
+            if (withNames) h = mix(h, renamed[node.varId()]);
+        } else if (node.isUnary()) {
+            h = mix(h, hashes[node.left]);
+        } else if (node.type == NodeType::IMPLIES) {
+            h = mix(mix(h, hashes[node.left]), hashes[node.right]);
+        } else {
+            // Interno de cadeia: não aparece na forma canônica
+            if (operands[id].empty()) continue;
+            sorted.clear();
+            for (NodeId x : operands[id]) sorted.push_back(hashes[x]);
+            std::sort(sorted.begin(), sorted.end());
+            for (uint64_t value : sorted) h = mix(h, value);
+        }
+        hashes[id] = h;
+    }
+}
+
+void Canonicalizer::sortOperands(const std::vector<uint64_t>& hashes) {
+    for (auto& list : operands) {
+        std::stable_sort(list.begin(), list.end(), [&](NodeId a, NodeId b) {
+            return hashes[a] < hashes[b];
+        });
+    }
+}
+
+void Canonicalizer::children(NodeId id, std::vector<NodeId>& out) const {
+    out.clear();
+    const ASTNode& node = formula.node(id);
+    if (node.isLeaf()) return;
+    if (isChain(node.type)) {
+        out = operands[id];
+    } else {
+        out.push_back(node.left);
+        if (node.isBinary()) out.push_back(node.right);
+    }
+}
+
+void Canonicalizer::renameVariables() {
+    renamed.assign(formula.numVariables(), UNNAMED);
+    uint32_t next = 0;
+
+    // Pré-ordem a partir da raiz, operandos na ordem canônica
+    std::vector<bool> visited(formula.size(), false);
+    std::vector<NodeId> pending(1, formula.getRoot());
+    std::vector<NodeId> kids;
+    while (!pending.empty()) {
+        NodeId id = pending.back();
+        pending.pop_back();
+        if (visited[id]) continue;
+        visited[id] = true;
+
+        const ASTNode& node = formula.node(id);
+        if (node.isLeaf()) {
+            if (renamed[node.varId()] == UNNAMED) renamed[node.varId()] = next++;
+            continue;
+        }
+        children(id, kids);
+        for (size_t i = kids.size(); i-- > 0;) {
+            pending.push_back(kids[i]);
+        }
+    }
+}
+
+std::string Canonicalizer::fingerprint() {
+    Sha256 hash;
+    hash.update("tautology-checker/canonical/1");
+    if (formula.empty()) return hash.hexDigest();
+
+    const size_t size = formula.size();
+    std::vector<bool> reachable(size, false);
+    reachable[formula.getRoot()] = true;
+    for (NodeId id = static_cast<NodeId>(size); id-- > 0;) {
+        if (!reachable[id]) continue;
+        const ASTNode& node = formula.node(id);
+        if (!node.isLeaf()) reachable[node.left] = true;
+        if (node.isBinary()) reachable[node.right] = true;
+    }
+
+    flatten(reachable);
+    hashNodes(reachable, shape, false);
+    sortOperands(shape);
+    renameVariables();
+    hashNodes(reachable, named, true);
+    sortOperands(named);
+
+    // Pós-ordem com hash-consing exato: subfórmulas canônicas iguais recebem
+    // o mesmo número, com ou sem compartilhamento no arena original
+    std::unordered_map<std::string, uint32_t> interned;
+    std::vector<uint32_t> number(size, UNNAMED);
+    std::vector<std::pair<NodeId, bool> > pending(1, std::make_pair(formula.getRoot(), false));
+    std::vector<NodeId> kids;
+    std::string key;
+    while (!pending.empty()) {
+        NodeId id = pending.back().first;
+        bool expanded = pending.back().second;
+        pending.pop_back();
+        if (number[id] != UNNAMED) continue;
+
+        const ASTNode& node = formula.node(id);
+        children(id, kids);
+        if (!expanded && !kids.empty()) {
+            pending.push_back(std::make_pair(id, true));
+            for (size_t i = kids.size(); i-- > 0;) {
+                pending.push_back(std::make_pair(kids[i], false));
+            }
+            continue;
+        }
+
+        key.assign(1, static_cast<char>(node.type));
+        if (node.isLeaf()) {
+            key.append(reinterpret_cast<const char*>(&renamed[node.varId()]), sizeof(uint32_t));
+        } else {
+            const uint32_t count = static_cast<uint32_t>(kids.size());
+            key.append(reinterpret_cast<const char*>(&count), sizeof(count));
+            for (NodeId x : kids) {
+                key.append(reinterpret_cast<const char*>(&number[x]), sizeof(uint32_t));
+            }
+        }
+
+        auto inserted = interned.insert(std::make_pair(key, static_cast<uint32_t>(interned.size())));
+        if (inserted.second) {
+            hash.update(key);
+        }
+        number[id] = inserted.first->second;
+    }
+
+    // A raiz fecha a serialização; o número de variáveis entra porque a
+    // contagem de modelos é sobre 2^n atribuições
+    hash.update(&number[formula.getRoot()], sizeof(uint32_t));
+    const uint32_t variables = static_cast<uint32_t>(formula.numVariables());
+    hash.update(&variables, sizeof(variables));
+    return hash.hexDigest();
+}
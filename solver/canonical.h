@@ -0,0 +1,47 @@
+#ifndef CANONICAL_H
+#define CANONICAL_H
+
+#include "../common/ast.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Forma canônica de uma fórmula a menos de renomeação de variáveis e da
+// ordem e do agrupamento dos operandos de ∧ e ∨:
+//   1. cadeias de ∧ (e de ∨) viram um único nó n-ário: (a ∧ b) ∧ c ≡ a ∧ (b ∧ c);
+//   2. os operandos de cada nó n-ário são ordenados por um hash da forma
+//      que ignora os nomes das variáveis;
+//   3. as variáveis são renomeadas pela ordem da primeira ocorrência;
+//   4. os operandos são reordenados com os novos nomes e o DAG resultante é
+//      serializado com hash-consing exato e resumido com SHA-256.
+// Duas fórmulas com a mesma impressão digital são iguais a menos de
+// renomeação e comutatividade/associatividade e, portanto, têm o mesmo
+// veredito e a mesma contagem de modelos. Empates na ordenação só podem
+// fazer fórmulas equivalentes terem impressões diferentes, nunca o contrário.
+class Canonicalizer {
+private:
+    const AST& formula;
+
+    // Operandos de cada nó que é cabeça de uma cadeia de ∧/∨ (vazio nos
+    // nós internos da cadeia e nos demais tipos)
+    std::vector<std::vector<NodeId> > operands;
+    std::vector<uint64_t> shape;        // Hash sem nomes de variáveis
+    std::vector<uint64_t> named;        // Hash com as variáveis renomeadas
+    std::vector<uint32_t> renamed;      // Novo índice de cada variável
+
+    void flatten(const std::vector<bool>& reachable);
+    void hashNodes(const std::vector<bool>& reachable, std::vector<uint64_t>& hashes, bool withNames);
+    void sortOperands(const std::vector<uint64_t>& hashes);
+    void renameVariables();
+
+    // Filhos de um nó na forma canônica
+    void children(NodeId id, std::vector<NodeId>& out) const;
+
+public:
+    explicit Canonicalizer(const AST& ast) : formula(ast) {}
+
+    // SHA-256 da forma canônica, em hexadecimal
+    std::string fingerprint();
+};
+
+#endif
@@ -0,0 +1,225 @@
+#include "compiled.h"
+#include "parallel.h"
+#include "perf_counters.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+// Verifica o timeout a cada 65536 atribuições
+static const uint64_t TIMEOUT_CHECK_INTERVAL = 65536;
+
+// Épocas usam 31 bits; ao se esgotarem a memoização é zerada
+static const uint32_t MAX_EPOCH = 0x7FFFFFFFu;
+
+CompiledFormula::CompiledFormula(const AST& ast)
+    : numMemoSlots(0), numVars(static_cast<int>(ast.numVariables())) {
+    if (ast.empty()) {
+        throw std::runtime_error("Fórmula vazia");
+    }
+    PhaseScope phase(SolverPhase::COMPILE);
+
+    std::vector<bool> shared = ast.sharedNodes();
+    memoSlotOf.assign(ast.size(), UINT32_MAX);
+    for (NodeId id = 0; id < ast.size(); ++id) {
+        if (shared[id]) {
+            memoSlotOf[id] = numMemoSlots++;
+        }
+    }
+
+    code.reserve(ast.size());
+    emit(ast, ast.getRoot());
+    threadJumps();
+}
+
+void CompiledFormula::emit(const AST& ast, NodeId id) {
+    if (memoSlotOf[id] == UINT32_MAX) {
+        emitNode(ast, id);
+        return;
+    }
+
+    // O código do nó compartilhado é repetido em cada ocorrência (o tamanho
+    // continua limitado pelo texto da fórmula), mas só executa uma vez
+    MemoSite site;
+    site.slot = memoSlotOf[id];
+    site.skip = 0;
+    size_t siteIndex = memoSites.size();
+    memoSites.push_back(site);
+
+    Instruction inst;
+    inst.op = OpCode::MEMO_LOAD;
+    inst.arg = static_cast<uint32_t>(siteIndex);
+    code.push_back(inst);
+
+    emitNode(ast, id);
+
+    inst.op = OpCode::MEMO_STORE;
+    inst.arg = site.slot;
+    code.push_back(inst);
+    memoSites[siteIndex].skip = static_cast<uint32_t>(code.size());
+}
+
+void CompiledFormula::emitNode(const AST& ast, NodeId id) {
+    const ASTNode& node = ast.node(id);
+    Instruction inst;
+    inst.arg = 0;
+
+    switch (node.type) {
+        case NodeType::VARIABLE:
+            inst.op = OpCode::LOAD;
+            inst.arg = node.varId();
+            code.push_back(inst);
+            return;
+        case NodeType::NOT:
+            emit(ast, node.left);
+            inst.op = OpCode::NOT;
+            code.push_back(inst);
+            return;
+        case NodeType::AND:
+        case NodeType::OR:
+        case NodeType::IMPLIES:
+            break;
+    }
+
+    emit(ast, node.left);
+    if (node.type == NodeType::IMPLIES) {
+        inst.op = OpCode::NOT; // p → q ≡ ¬p ∨ q
+        code.push_back(inst);
+    }
+
+    // O destino do desvio só é conhecido depois de emitir o lado direito
+    inst.op = (node.type == NodeType::AND) ? OpCode::JUMP_IF_FALSE : OpCode::JUMP_IF_TRUE;
+    size_t jump = code.size();
+    code.push_back(inst);
+
+    emit(ast, node.right);
+    code[jump].arg = static_cast<uint32_t>(code.size());
+}
+
+void CompiledFormula::threadJumps() {
+    // Um desvio que cai em outro desvio com o mesmo acumulador pode ir direto
+    // ao destino final: JUMP_IF_FALSE → JUMP_IF_FALSE segue o segundo desvio,
+    // JUMP_IF_FALSE → JUMP_IF_TRUE nunca é tomado e segue adiante.
+    // Os desvios são sempre para frente, então o laço termina.
+    for (size_t pc = 0; pc < code.size(); ++pc) {
+        Instruction& inst = code[pc];
+        if (inst.op != OpCode::JUMP_IF_FALSE && inst.op != OpCode::JUMP_IF_TRUE) {
+            continue;
+        }
+
+        uint32_t target = inst.arg;
+        while (target < code.size()) {
+            const Instruction& next = code[target];
+            if (next.op == inst.op) {
+                target = next.arg;
+            } else if (next.op == OpCode::JUMP_IF_FALSE || next.op == OpCode::JUMP_IF_TRUE) {
+                target++;
+            } else {
+                break;
+            }
+        }
+        inst.arg = target;
+    }
+}
+
+void CompiledFormula::print(std::ostream& out) const {
+    for (size_t pc = 0; pc < code.size(); ++pc) {
+        out << "  " << pc << ": ";
+        switch (code[pc].op) {
+            case OpCode::LOAD:
+                out << "LOAD " << code[pc].arg;
+                break;
+            case OpCode::NOT:
+                out << "NOT";
+                break;
+            case OpCode::JUMP_IF_FALSE:
+                out << "JUMP_IF_FALSE " << code[pc].arg;
+                break;
+            case OpCode::JUMP_IF_TRUE:
+                out << "JUMP_IF_TRUE " << code[pc].arg;
+                break;
+            case OpCode::MEMO_LOAD:
+                out << "MEMO_LOAD " << memoSites[code[pc].arg].slot
+                          << " (pula para " << memoSites[code[pc].arg].skip << ")";
+                break;
+            case OpCode::MEMO_STORE:
+                out << "MEMO_STORE " << code[pc].arg;
+                break;
+        }
+        out << std::endl;
+    }
+}
+
+bool CompiledEvaluator::sweepRows(const CompiledFormula& program, uint64_t begin, uint64_t end,
+                                  Evaluator::Metrics& m, const std::atomic<bool>* stop) {
+    const int n = program.numVariables();
+
+    // Mesma ordem de generateTruthTable: o slot 0 é o bit mais significativo
+    std::vector<uint8_t> values(n);
+    for (int j = 0; j < n; ++j) {
+        values[j] = (begin >> (n - 1 - j)) & 1;
+    }
+
+    std::vector<uint32_t> memo(program.memoSlots(), 0);
+    uint32_t epoch = 0;
+
+    for (uint64_t row = begin; row < end; ++row) {
+        if (stop && stop->load(std::memory_order_relaxed)) {
+            return true;
+        }
+
+        if (++epoch == MAX_EPOCH) {
+            std::fill(memo.begin(), memo.end(), 0);
+            epoch = 1;
+        }
+
+        m.evaluations++;
+        if (!program.evaluate(values.data(), memo.data(), epoch, m.stackOperations)) {
+            return false;
+        }
+
+        // Incrementa o contador binário
+        for (int j = n - 1; j >= 0; --j) {
+            if (values[j] == 0) {
+                values[j] = 1;
+                break;
+            }
+            values[j] = 0;
+        }
+    }
+
+    return true;
+}
+
+bool CompiledEvaluator::isTautology(const CompiledFormula& program) {
+    resetMetrics();
+    metrics.maxStackSize = 1;
+
+    const uint64_t numRows = 1ULL << program.numVariables();
+
+    if (numThreads != 1) {
+        ParallelSweep sweep(numThreads, 4096);
+        bool result = sweep.run(numRows, [&](int, uint64_t begin, uint64_t end, Evaluator::Metrics& m) {
+            return sweepRows(program, begin, end, m, sweep.stopFlag());
+        }, deadline);
+
+        metrics = sweep.metrics;
+        metrics.maxStackSize = 1;
+        return result;
+    }
+
+    for (uint64_t row = 0; row < numRows; row += TIMEOUT_CHECK_INTERVAL) {
+        if (deadline != nullptr && row > 0) {
+            deadline->check();
+        }
+
+        if (!sweepRows(program, row, std::min(numRows, row + TIMEOUT_CHECK_INTERVAL), metrics, nullptr)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void CompiledEvaluator::resetMetrics() {
+    metrics = Evaluator::Metrics();
+}
@@ -0,0 +1,133 @@
+#ifndef COMPILED_H
+#define COMPILED_H
+
+#include "../common/ast.h"
+#include "evaluator.h"
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// Fórmula compilada para um programa linear com desvios condicionais.
+// Como todo operador binário é avaliado em curto-circuito, o resultado
+// parcial cabe em um único acumulador:
+//   A ∧ B  →  A; JUMP_IF_FALSE fim; B
+//   A ∨ B  →  A; JUMP_IF_TRUE fim; B
+//   A → B  →  A; NOT; JUMP_IF_TRUE fim; B
+// Em um DAG, cada ocorrência de um nó compartilhado fica entre MEMO_LOAD e
+// MEMO_STORE, então ele é calculado no máximo uma vez por atribuição.
+class CompiledFormula {
+public:
+    enum class OpCode : uint8_t {
+        LOAD,           // acc = valor do slot da variável
+        NOT,            // acc = ¬acc
+        JUMP_IF_FALSE,  // se ¬acc, desvia para arg
+        JUMP_IF_TRUE,   // se acc, desvia para arg
+        MEMO_LOAD,      // se o sítio arg já tem valor nesta atribuição, acc = valor e pula o cálculo
+        MEMO_STORE      // guarda acc no slot de memoização arg
+    };
+
+    struct Instruction {
+        OpCode op;
+        uint32_t arg;   // Slot da variável, destino do desvio ou índice de memoização
+    };
+
+    // Ocorrência de um nó compartilhado: slot de memoização e fim do seu código
+    struct MemoSite {
+        uint32_t slot;
+        uint32_t skip;
+    };
+
+private:
+    std::vector<Instruction> code;
+    std::vector<MemoSite> memoSites;
+    std::vector<uint32_t> memoSlotOf;
+    uint32_t numMemoSlots;
+    int numVars;
+
+    void emit(const AST& ast, NodeId id);
+    void emitNode(const AST& ast, NodeId id);
+    void threadJumps();
+
+public:
+    // Os slots são os IDs densos das variáveis (o ID 0 é o bit mais significativo)
+    explicit CompiledFormula(const AST& ast);
+
+    // Avalia com assignment[slot] ∈ {0, 1}; soma em executed as instruções executadas.
+    // memo tem memoSlots() entradas no formato (época << 1) | valor, e epoch
+    // deve mudar a cada atribuição.
+    bool evaluate(const uint8_t* assignment, uint32_t* memo, uint32_t epoch, long long& executed) const {
+        const Instruction* ins = code.data();
+        const size_t size = code.size();
+        bool acc = false;
+        size_t pc = 0;
+
+        while (pc < size) {
+            const Instruction& i = ins[pc];
+            executed++;
+            switch (i.op) {
+                case OpCode::LOAD:
+                    acc = assignment[i.arg] != 0;
+                    pc++;
+                    break;
+                case OpCode::NOT:
+                    acc = !acc;
+                    pc++;
+                    break;
+                case OpCode::JUMP_IF_FALSE:
+                    pc = acc ? pc + 1 : i.arg;
+                    break;
+                case OpCode::JUMP_IF_TRUE:
+                    pc = acc ? i.arg : pc + 1;
+                    break;
+                case OpCode::MEMO_LOAD: {
+                    const MemoSite& site = memoSites[i.arg];
+                    if ((memo[site.slot] >> 1) == epoch) {
+                        acc = memo[site.slot] & 1;
+                        pc = site.skip;
+                    } else {
+                        pc++;
+                    }
+                    break;
+                }
+                case OpCode::MEMO_STORE:
+                    memo[i.arg] = (epoch << 1) | (acc ? 1 : 0);
+                    pc++;
+                    break;
+            }
+        }
+
+        return acc;
+    }
+
+    size_t size() const { return code.size(); }
+    size_t memoSlots() const { return numMemoSlots; }
+    int numVariables() const { return numVars; }
+
+    void print(std::ostream& out = std::cout) const;
+};
+
+// Varredura da tabela verdade sobre a fórmula compilada, sem alocação por linha
+class CompiledEvaluator {
+private:
+    const Deadline* deadline;
+    int numThreads;
+
+    static bool sweepRows(const CompiledFormula& program, uint64_t begin, uint64_t end,
+                          Evaluator::Metrics& m, const std::atomic<bool>* stop);
+
+public:
+    CompiledEvaluator(const Deadline* limit = nullptr)
+        : deadline(limit), numThreads(1) {}
+
+    void setThreads(int threads) { numThreads = threads; }
+
+    bool isTautology(const CompiledFormula& program);
+
+    // evaluations conta atribuições, stackOperations as instruções executadas;
+    // maxStackSize é sempre 1 (o acumulador)
+    Evaluator::Metrics metrics;
+    void resetMetrics();
+};
+
+#endif
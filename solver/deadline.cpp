@@ -0,0 +1,34 @@
+#include "deadline.h"
+#include <stdexcept>
+
+const long long Deadline::MAX_BUDGET_MS;
+
+static long long clampBudget(long long milliseconds) {
+    if (milliseconds <= 0) return 0;
+    return milliseconds < Deadline::MAX_BUDGET_MS ? milliseconds : Deadline::MAX_BUDGET_MS;
+}
+
+Deadline::Deadline(long long milliseconds, const Deadline* parentDeadline, const std::string& what)
+    : limit(std::chrono::steady_clock::now() + std::chrono::milliseconds(clampBudget(milliseconds))),
+      budgetMs(clampBudget(milliseconds)), parent(parentDeadline), scope(what), cancelled(false) {}
+
+bool Deadline::expired() const {
+    if (cancelled.load(std::memory_order_relaxed)) return true;
+    if (budgetMs > 0 && std::chrono::steady_clock::now() > limit) {
+        // Depois da primeira vez que expira, as consultas não leem mais o relógio
+        cancelled.store(true, std::memory_order_relaxed);
+        return true;
+    }
+    return parent != nullptr && parent->expired();
+}
+
+void Deadline::check() const {
+    if (!expired()) return;
+    if (parent != nullptr && parent->expired()) {
+        parent->check();
+    }
+    if (budgetMs > 0 && std::chrono::steady_clock::now() > limit) {
+        throw std::runtime_error("TIMEOUT: " + scope + " exceeded " + std::to_string(budgetMs) + " milliseconds");
+    }
+    throw std::runtime_error("TIMEOUT: " + scope + " cancelled");
+}
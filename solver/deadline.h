@@ -0,0 +1,46 @@
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+// Prazo cooperativo de uma resolução. Nada é interrompido de fora: os motores
+// consultam expired() ou check() a cada alguns milhares de atribuições ou nós
+// e saem do laço normalmente, liberando o próprio estado. É seguro consultar
+// o mesmo prazo de várias threads.
+//
+// Um prazo pode ter um pai (por exemplo, o orçamento do lote inteiro): ele
+// expira quando o próprio prazo acaba, quando o do pai acaba ou quando
+// alguém chama cancel().
+class Deadline {
+private:
+    std::chrono::steady_clock::time_point limit;
+    long long budgetMs;                 // 0 = sem limite de tempo
+    const Deadline* parent;
+    std::string scope;                  // Usado na mensagem de TIMEOUT
+    mutable std::atomic<bool> cancelled;
+
+    Deadline(const Deadline&);
+    Deadline& operator=(const Deadline&);
+
+public:
+    // Prazos maiores (uns 30 anos) são reduzidos a este, para que o limite
+    // caiba no relógio em nanossegundos
+    static const long long MAX_BUDGET_MS = 1000000000000LL;
+
+    explicit Deadline(long long milliseconds = 0, const Deadline* parentDeadline = nullptr,
+                      const std::string& what = "Formula evaluation");
+
+    // Faz todas as consultas seguintes (inclusive dos filhos) expirarem
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+
+    bool expired() const;
+
+    // Lança runtime_error("TIMEOUT: ...") se o prazo expirou
+    void check() const;
+
+    long long budget() const { return budgetMs; }
+};
+
+#endif
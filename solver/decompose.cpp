@@ -0,0 +1,47 @@
+#include "decompose.h"
+#include <algorithm>
+#include <unordered_map>
+
+std::vector<AST> ConjunctDecomposer::split(const AST& formula) {
+    std::vector<AST> parts;
+    if (formula.empty()) return parts;
+
+    // Percorre a espinha de ∧ da esquerda para a direita; com hash-consing
+    // um termo repetido é o mesmo nó e entra uma única vez
+    std::vector<NodeId> pending(1, formula.getRoot());
+    std::vector<bool> seen(formula.size(), false);
+    while (!pending.empty()) {
+        NodeId id = pending.back();
+        pending.pop_back();
+        if (seen[id]) continue;
+        seen[id] = true;
+
+        const ASTNode& node = formula.node(id);
+        if (node.type == NodeType::AND) {
+            pending.push_back(node.right);
+            pending.push_back(node.left);
+            continue;
+        }
+
+        parts.push_back(formula.extract(id));
+        parts.back().sortVariables();
+    }
+
+    std::stable_sort(parts.begin(), parts.end(), [](const AST& a, const AST& b) {
+        return a.numVariables() < b.numVariables();
+    });
+    return parts;
+}
+
+std::vector<bool> ConjunctDecomposer::liftAssignment(const AST& part, const std::vector<bool>& model, const AST& whole) {
+    std::unordered_map<std::string, uint32_t> ids;
+    for (uint32_t v = 0; v < whole.numVariables(); ++v) {
+        ids[whole.variableName(v)] = v;
+    }
+
+    std::vector<bool> lifted(whole.numVariables(), false);
+    for (uint32_t v = 0; v < model.size(); ++v) {
+        lifted[ids[part.variableName(v)]] = model[v];
+    }
+    return lifted;
+}
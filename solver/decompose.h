@@ -0,0 +1,22 @@
+#ifndef DECOMPOSE_H
+#define DECOMPOSE_H
+
+#include "../common/ast.h"
+#include <vector>
+
+// Uma conjunção é tautologia se e somente se cada termo é. O decompositor
+// achata a espinha de ∧ do topo da fórmula e devolve cada termo como uma
+// AST própria, só com as suas variáveis, para ser verificado separadamente
+// sobre 2^k linhas em vez de 2^n.
+class ConjunctDecomposer {
+public:
+    // Termos em ordem crescente de número de variáveis (os mais baratos
+    // primeiro); uma fórmula sem ∧ na raiz resulta em um único termo
+    static std::vector<AST> split(const AST& formula);
+
+    // Leva o contraexemplo de um termo para as variáveis da fórmula
+    // inteira; as variáveis que não aparecem no termo ficam falsas
+    static std::vector<bool> liftAssignment(const AST& part, const std::vector<bool>& model, const AST& whole);
+};
+
+#endif
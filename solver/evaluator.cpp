@@ -1,61 +1,83 @@
 #include "evaluator.h"
-#include "../common/utils.h"
+#include "parallel.h"
 #include <iostream>
 #include <algorithm>
+#include <stack>
+#include <stdexcept>
+
+// Linhas avaliadas entre duas consultas ao prazo (potência de 2)
+static const uint64_t DEADLINE_CHECK_INTERVAL = 4096;
 
 struct StackFrame {
-    std::shared_ptr<ASTNode> node;
+    NodeId node;
     bool visited;  // Para pós-ordem
-    bool value;    // Para armazenar resultado
     
-    StackFrame(std::shared_ptr<ASTNode> n) : node(n), visited(false), value(false) {}
+    StackFrame(NodeId n) : node(n), visited(false) {}
 };
 
-void Evaluator::setAssignment(const std::unordered_map<std::string, bool>& assignment) {
+void Evaluator::setAssignment(const std::vector<bool>& assignment) {
     this->assignment = assignment;
 }
 
-bool Evaluator::evaluate(std::shared_ptr<ASTNode> root) {
+void Evaluator::prepare(const AST& ast) {
+    shared = ast.sharedNodes();
+    memoEpoch.assign(ast.size(), 0);
+    memoValue.assign(ast.size(), false);
+    epoch = 0;
+}
+
+bool Evaluator::evaluate(const AST& ast) {
     metrics.evaluations++;
-    return evaluateIterative(root);
+    if (++epoch == 0) {
+        // Contador deu a volta: invalida tudo que estava memoizado
+        std::fill(memoEpoch.begin(), memoEpoch.end(), 0);
+        epoch = 1;
+    }
+    return evaluateIterative(ast);
 }
 
-bool Evaluator::evaluateIterative(std::shared_ptr<ASTNode> root) {
-    if (!root) return false;
+bool Evaluator::evaluateIterative(const AST& ast) {
+    if (ast.empty()) return false;
     
     std::stack<StackFrame> evalStack;
     std::stack<bool> valueStack;
+    const bool memoize = shared.size() == ast.size();
     
-    evalStack.push(StackFrame(root));
+    evalStack.push(StackFrame(ast.getRoot()));
     metrics.maxStackSize = std::max(metrics.maxStackSize, evalStack.size());
     
     while (!evalStack.empty()) {
         StackFrame& frame = evalStack.top();
+        const ASTNode& node = ast.node(frame.node);
         metrics.stackOperations++;
         
-        if (frame.node->isLeaf()) {
+        if (node.isLeaf()) {
             // Variável
-            if (frame.node->type == NodeType::VARIABLE) {
-                auto it = assignment.find(frame.node->value);
-                if (it != assignment.end()) {
-                    valueStack.push(it->second);
-                } else {
-                    throw std::runtime_error("Variável não encontrada: " + frame.node->value);
-                }
+            if (node.varId() < assignment.size()) {
+                valueStack.push(assignment[node.varId()]);
+            } else {
+                throw std::runtime_error("Variável não encontrada: " + ast.variableName(node.varId()));
             }
             evalStack.pop();
             
         } else if (!frame.visited) {
+            // Nó compartilhado já calculado nesta atribuição
+            if (memoize && shared[frame.node] && memoEpoch[frame.node] == epoch) {
+                valueStack.push(memoValue[frame.node]);
+                evalStack.pop();
+                continue;
+            }
+            
             // Primeira visita - empilha filhos
             frame.visited = true;
             
-            if (frame.node->type == NodeType::NOT) {
+            if (node.type == NodeType::NOT) {
                 // Unário
-                evalStack.push(StackFrame(frame.node->left));
+                evalStack.push(StackFrame(node.left));
             } else {
                 // Binário - empilha na ordem inversa (direita primeiro)
-                evalStack.push(StackFrame(frame.node->right));
-                evalStack.push(StackFrame(frame.node->left));
+                evalStack.push(StackFrame(node.right));
+                evalStack.push(StackFrame(node.left));
             }
             
             metrics.maxStackSize = std::max(metrics.maxStackSize, evalStack.size());
@@ -64,7 +86,7 @@ bool Evaluator::evaluateIterative(std::shared_ptr<ASTNode> root) {
             // Segunda visita - processa operação
             bool result = false;
             
-            switch (frame.node->type) {
+            switch (node.type) {
                 case NodeType::NOT: {
                     bool operand = valueStack.top();
                     valueStack.pop();
@@ -93,6 +115,11 @@ bool Evaluator::evaluateIterative(std::shared_ptr<ASTNode> root) {
                     throw std::runtime_error("Tipo de nó desconhecido");
             }
             
+            if (memoize && shared[frame.node]) {
+                memoEpoch[frame.node] = epoch;
+                memoValue[frame.node] = result;
+            }
+            
             valueStack.push(result);
             evalStack.pop();
         }
@@ -105,45 +132,49 @@ bool Evaluator::evaluateIterative(std::shared_ptr<ASTNode> root) {
     return valueStack.top();
 }
 
-bool Evaluator::evaluateRecursive(std::shared_ptr<ASTNode> node) {
-    if (!node) return false;
+bool Evaluator::evaluateRecursive(const AST& ast, NodeId id) {
+    const ASTNode& node = ast.node(id);
     
-    switch (node->type) {
+    switch (node.type) {
         case NodeType::VARIABLE: {
-            auto it = assignment.find(node->value);
-            if (it != assignment.end()) {
-                return it->second;
+            if (node.varId() < assignment.size()) {
+                return assignment[node.varId()];
             } else {
-                throw std::runtime_error("Variável não encontrada: " + node->value);
+                throw std::runtime_error("Variável não encontrada: " + ast.variableName(node.varId()));
             }
         }
         case NodeType::NOT:
-            return !evaluateRecursive(node->left);
+            return !evaluateRecursive(ast, node.left);
         case NodeType::AND:
-            return evaluateRecursive(node->left) && evaluateRecursive(node->right);
+            return evaluateRecursive(ast, node.left) && evaluateRecursive(ast, node.right);
         case NodeType::OR:
-            return evaluateRecursive(node->left) || evaluateRecursive(node->right);
+            return evaluateRecursive(ast, node.left) || evaluateRecursive(ast, node.right);
         case NodeType::IMPLIES:
-            return !evaluateRecursive(node->left) || evaluateRecursive(node->right);
+            return !evaluateRecursive(ast, node.left) || evaluateRecursive(ast, node.right);
         default:
             throw std::runtime_error("Tipo de nó desconhecido");
     }
 }
 
-bool Evaluator::isTautology(std::shared_ptr<ASTNode> root, const std::vector<std::string>& variables) {
+bool Evaluator::isTautology(const AST& ast, const Deadline* deadline) {
     resetMetrics();
+    prepare(ast);
     
-    auto truthTable = FileUtils::generateTruthTable(variables.size());
+    // Mesma ordem de generateTruthTable, sem materializar a tabela inteira
+    const size_t n = ast.numVariables();
+    const uint64_t numRows = 1ULL << n;
+    assignment.assign(n, false);
     
-    for (const auto& row : truthTable) {
-        std::unordered_map<std::string, bool> currentAssignment;
-        for (size_t i = 0; i < variables.size(); ++i) {
-            currentAssignment[variables[i]] = row[i];
+    for (uint64_t row = 0; row < numRows; ++row) {
+        if (deadline != nullptr && (row & (DEADLINE_CHECK_INTERVAL - 1)) == 0) {
+            deadline->check();
         }
         
-        setAssignment(currentAssignment);
+        for (size_t i = 0; i < n; ++i) {
+            assignment[i] = (row >> (n - 1 - i)) & 1;
+        }
         
-        if (!evaluate(root)) {
+        if (!evaluate(ast)) {
             return false; 
         }
     }
@@ -151,6 +182,42 @@ bool Evaluator::isTautology(std::shared_ptr<ASTNode> root, const std::vector<std
     return true;
 }
 
+bool Evaluator::isTautologyParallel(const AST& ast, int numThreads, const Deadline* deadline) {
+    resetMetrics();
+    
+    const size_t n = ast.numVariables();
+    const uint64_t numRows = 1ULL << n;
+    
+    ParallelSweep sweep(numThreads, 4096);
+    std::vector<Evaluator> workers(ParallelSweep::resolveThreads(numThreads));
+    for (auto& worker : workers) {
+        worker.prepare(ast);
+    }
+    
+    bool result = sweep.run(numRows, [&](int id, uint64_t begin, uint64_t end, Metrics& workerMetrics) {
+        Evaluator& worker = workers[id];
+        worker.assignment.assign(n, false);
+        
+        for (uint64_t row = begin; row < end && !sweep.shouldStop(); ++row) {
+            // Mesma ordem de generateTruthTable: a variável 0 é o bit mais significativo
+            for (size_t i = 0; i < n; ++i) {
+                worker.assignment[i] = (row >> (n - 1 - i)) & 1;
+            }
+            
+            if (!worker.evaluate(ast)) {
+                workerMetrics = worker.metrics;
+                return false;
+            }
+        }
+        
+        workerMetrics = worker.metrics;
+        return true;
+    }, deadline);
+    
+    metrics = sweep.metrics;
+    return result;
+}
+
 void Evaluator::resetMetrics() {
     metrics = Metrics();
 }
\ No newline at end of file
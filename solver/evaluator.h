@@ -2,34 +2,53 @@
 #define EVALUATOR_H
 
 #include "../common/ast.h"
-#include <unordered_map>
-#include <stack>
+#include "deadline.h"
+#include <vector>
 
 class Evaluator {
 private:
-    std::unordered_map<std::string, bool> assignment;
+    // Valor de cada variável, indexado pelo ID denso da AST
+    std::vector<bool> assignment;
     
-    bool evaluateIterative(std::shared_ptr<ASTNode> root);
+    // Memoização dos nós compartilhados do DAG, válida só na atribuição atual
+    std::vector<bool> shared;
+    std::vector<uint32_t> memoEpoch;
+    std::vector<bool> memoValue;
+    uint32_t epoch;
     
-    bool evaluateRecursive(std::shared_ptr<ASTNode> node);
+    bool evaluateIterative(const AST& ast);
+    
+    bool evaluateRecursive(const AST& ast, NodeId node);
     
 public:
-    void setAssignment(const std::unordered_map<std::string, bool>& assignment);
+    Evaluator() : epoch(0) {}
+    
+    void setAssignment(const std::vector<bool>& assignment);
+    
+    // Ativa a memoização para que cada nó compartilhado seja calculado uma
+    // única vez por atribuição (sem efeito em árvores)
+    void prepare(const AST& ast);
+    
+    bool evaluate(const AST& ast);
     
-    bool evaluate(std::shared_ptr<ASTNode> root);
+    // A variável de ID 0 é o bit mais significativo da tabela verdade.
+    // O prazo é consultado a cada 4096 linhas.
+    bool isTautology(const AST& ast, const Deadline* deadline = nullptr);
     
-    bool isTautology(std::shared_ptr<ASTNode> root, const std::vector<std::string>& variables);
+    // Divide as 2^n linhas entre threads (0 = todos os núcleos) e agrega as métricas
+    bool isTautologyParallel(const AST& ast, int numThreads, const Deadline* deadline = nullptr);
     
     struct Metrics {
         long long evaluations;
         long long stackOperations;
         size_t maxStackSize;
+        long long compileTime;  // μs gerando código nativo (JIT); 0 se não houve
         
-        Metrics() : evaluations(0), stackOperations(0), maxStackSize(0) {}
+        Metrics() : evaluations(0), stackOperations(0), maxStackSize(0), compileTime(0) {}
     };
     
     Metrics metrics;
     void resetMetrics();
 };
 
-#endif
+#endif
\ No newline at end of file
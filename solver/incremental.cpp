@@ -0,0 +1,214 @@
+#include "incremental.h"
+#include "parallel.h"
+#include "perf_counters.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+// Cada chunk recomeça com uma avaliação completa; entre chunks verifica o timeout
+static const uint64_t CHUNK_ROWS = 65536;
+
+void IncrementalEvaluator::buildIndex() {
+    const size_t size = ast->size();
+
+    // Só os nós alcançáveis a partir da raiz participam
+    std::vector<bool> reachable(size, false);
+    std::vector<NodeId> pending(1, ast->getRoot());
+    while (!pending.empty()) {
+        NodeId id = pending.back();
+        pending.pop_back();
+        if (reachable[id]) continue;
+        reachable[id] = true;
+
+        const ASTNode& node = ast->node(id);
+        if (!node.isLeaf()) pending.push_back(node.left);
+        if (node.isBinary()) pending.push_back(node.right);
+    }
+
+    std::vector<uint32_t> parentCount(size + 1, 0);
+    std::vector<uint32_t> leafCount(numVars + 1, 0);
+    for (NodeId id = 0; id < size; ++id) {
+        if (!reachable[id]) continue;
+        const ASTNode& node = ast->node(id);
+        if (node.isLeaf()) {
+            leafCount[node.varId()]++;
+            continue;
+        }
+        parentCount[node.left]++;
+        if (node.isBinary() && node.right != node.left) parentCount[node.right]++;
+    }
+
+    parentStart.assign(size + 1, 0);
+    for (size_t i = 0; i < size; ++i) parentStart[i + 1] = parentStart[i] + parentCount[i];
+    leafStart.assign(numVars + 1, 0);
+    for (int v = 0; v < numVars; ++v) leafStart[v + 1] = leafStart[v] + leafCount[v];
+
+    parentList.assign(parentStart[size], 0);
+    leafList.assign(leafStart[numVars], 0);
+    std::vector<uint32_t> parentFill(parentStart.begin(), parentStart.end() - 1);
+    std::vector<uint32_t> leafFill(leafStart.begin(), leafStart.end() - 1);
+
+    for (NodeId id = 0; id < size; ++id) {
+        if (!reachable[id]) continue;
+        const ASTNode& node = ast->node(id);
+        if (node.isLeaf()) {
+            leafList[leafFill[node.varId()]++] = id;
+            continue;
+        }
+        parentList[parentFill[node.left]++] = id;
+        if (node.isBinary() && node.right != node.left) parentList[parentFill[node.right]++] = id;
+    }
+}
+
+uint8_t IncrementalEvaluator::computeNode(const Workspace& ws, NodeId id) const {
+    const ASTNode& node = ast->node(id);
+    switch (node.type) {
+        case NodeType::VARIABLE:
+            return ws.assignment[node.varId()];
+        case NodeType::NOT:
+            return !ws.values[node.left];
+        case NodeType::AND:
+            return ws.values[node.left] && ws.values[node.right];
+        case NodeType::OR:
+            return ws.values[node.left] || ws.values[node.right];
+        case NodeType::IMPLIES:
+            return !ws.values[node.left] || ws.values[node.right];
+    }
+    throw std::runtime_error("Tipo de nó desconhecido");
+}
+
+void IncrementalEvaluator::evaluateAll(Workspace& ws, uint64_t gray) const {
+    // A variável 0 é o bit mais significativo, como na tabela verdade
+    for (int j = 0; j < numVars; ++j) {
+        ws.assignment[j] = (gray >> (numVars - 1 - j)) & 1;
+    }
+    // Filhos têm índice menor que os pais: uma passada em ordem basta
+    for (NodeId id = 0; id < ast->size(); ++id) {
+        ws.values[id] = computeNode(ws, id);
+    }
+}
+
+void IncrementalEvaluator::flipVariable(Workspace& ws, int var, Evaluator::Metrics& m) const {
+    ws.assignment[var] ^= 1;
+    ws.step++;
+
+    // Fila de prioridade pelo índice do nó: como os filhos vêm antes dos pais,
+    // cada nó sujo é recalculado uma única vez, depois de todos os seus filhos
+    auto enqueueParents = [&](NodeId id) {
+        for (uint32_t p = parentStart[id]; p < parentStart[id + 1]; ++p) {
+            NodeId parent = parentList[p];
+            if (ws.queuedAt[parent] != ws.step) {
+                ws.queuedAt[parent] = ws.step;
+                ws.heap.push_back(parent);
+                std::push_heap(ws.heap.begin(), ws.heap.end(), std::greater<NodeId>());
+            }
+        }
+    };
+
+    for (uint32_t l = leafStart[var]; l < leafStart[var + 1]; ++l) {
+        NodeId leaf = leafList[l];
+        ws.values[leaf] ^= 1;
+        enqueueParents(leaf);
+    }
+    m.maxStackSize = std::max(m.maxStackSize, ws.heap.size());
+
+    while (!ws.heap.empty()) {
+        std::pop_heap(ws.heap.begin(), ws.heap.end(), std::greater<NodeId>());
+        NodeId id = ws.heap.back();
+        ws.heap.pop_back();
+
+        m.stackOperations++;
+        uint8_t value = computeNode(ws, id);
+        if (value != ws.values[id]) {
+            ws.values[id] = value;
+            enqueueParents(id);
+            m.maxStackSize = std::max(m.maxStackSize, ws.heap.size());
+        }
+    }
+}
+
+bool IncrementalEvaluator::sweepRange(Workspace& ws, uint64_t begin, uint64_t end, Evaluator::Metrics& m,
+                                      const std::atomic<bool>* stop) const {
+    const NodeId root = ast->getRoot();
+
+    evaluateAll(ws, begin ^ (begin >> 1));
+    m.stackOperations += ast->size();
+    m.evaluations++;
+    if (!ws.values[root]) {
+        return false;
+    }
+
+    for (uint64_t row = begin + 1; row < end; ++row) {
+        if (stop && stop->load(std::memory_order_relaxed)) {
+            return true;
+        }
+
+        // Da linha row-1 para row muda só o bit menos significativo ligado em row
+        int bit = __builtin_ctzll(row);
+        flipVariable(ws, numVars - 1 - bit, m);
+
+        m.evaluations++;
+        if (!ws.values[root]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool IncrementalEvaluator::isTautology(const AST& formula) {
+    resetMetrics();
+    if (formula.empty()) return false;
+
+    ast = &formula;
+    numVars = static_cast<int>(formula.numVariables());
+    {
+        PhaseScope phase(SolverPhase::COMPILE);
+        buildIndex();
+    }
+
+    auto newWorkspace = [&]() {
+        Workspace ws;
+        ws.values.assign(formula.size(), 0);
+        ws.assignment.assign(numVars, 0);
+        ws.queuedAt.assign(formula.size(), 0);
+        ws.step = 0;
+        return ws;
+    };
+
+    const uint64_t numRows = 1ULL << numVars;
+
+    if (numThreads != 1) {
+        ParallelSweep sweep(numThreads, CHUNK_ROWS);
+        std::vector<Workspace> workspaces;
+        for (int i = 0; i < ParallelSweep::resolveThreads(numThreads); ++i) {
+            workspaces.push_back(newWorkspace());
+        }
+
+        bool result = sweep.run(numRows, [&](int id, uint64_t begin, uint64_t end, Evaluator::Metrics& m) {
+            return sweepRange(workspaces[id], begin, end, m, sweep.stopFlag());
+        }, deadline);
+
+        metrics = sweep.metrics;
+        return result;
+    }
+
+    Workspace ws = newWorkspace();
+
+    for (uint64_t row = 0; row < numRows; row += CHUNK_ROWS) {
+        if (deadline != nullptr && row > 0) {
+            deadline->check();
+        }
+
+        if (!sweepRange(ws, row, std::min(numRows, row + CHUNK_ROWS), metrics, nullptr)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void IncrementalEvaluator::resetMetrics() {
+    metrics = Evaluator::Metrics();
+}
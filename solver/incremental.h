@@ -0,0 +1,60 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include "../common/ast.h"
+#include "evaluator.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Avaliação incremental em ordem de código Gray: entre duas linhas
+// consecutivas só uma variável muda, então basta reavaliar os caminhos que
+// saem das folhas dessa variável até a raiz, parando assim que o valor de
+// um nó não se altera. O custo por linha é proporcional ao cone afetado,
+// não ao tamanho da fórmula.
+class IncrementalEvaluator {
+private:
+    // Estado de uma varredura: valores em cache e fila de nós sujos
+    struct Workspace {
+        std::vector<uint8_t> values;
+        std::vector<uint8_t> assignment;
+        std::vector<uint64_t> queuedAt;
+        std::vector<NodeId> heap;
+        uint64_t step;
+    };
+
+    const AST* ast;
+    int numVars;
+    const Deadline* deadline;
+    int numThreads;
+
+    // Listas de pais e de folhas por variável (formato CSR)
+    std::vector<uint32_t> parentStart;
+    std::vector<NodeId> parentList;
+    std::vector<uint32_t> leafStart;
+    std::vector<NodeId> leafList;
+
+    void buildIndex();
+    uint8_t computeNode(const Workspace& ws, NodeId id) const;
+    void evaluateAll(Workspace& ws, uint64_t gray) const;
+    void flipVariable(Workspace& ws, int var, Evaluator::Metrics& m) const;
+
+    // Avalia as linhas de Gray [begin, end); false se alguma falsificar a fórmula
+    bool sweepRange(Workspace& ws, uint64_t begin, uint64_t end, Evaluator::Metrics& m,
+                    const std::atomic<bool>* stop) const;
+
+public:
+    IncrementalEvaluator(const Deadline* limit = nullptr)
+        : ast(nullptr), numVars(0), deadline(limit), numThreads(1) {}
+
+    void setThreads(int threads) { numThreads = threads; }
+
+    bool isTautology(const AST& formula);
+
+    // evaluations conta atribuições, stackOperations os nós reavaliados
+    // e maxStackSize o maior tamanho da fila de nós sujos
+    Evaluator::Metrics metrics;
+    void resetMetrics();
+};
+
+#endif
@@ -0,0 +1,324 @@
+#include "jit.h"
+#include <cstring>
+#include <utility>
+
+#if defined(__x86_64__) && !defined(_WIN32)
+#define JIT_X86_64 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Programas maiores que isso ficam no interpretador: o código passaria de
+// algumas dezenas de MB e os deslocamentos de 32 bits dos derramamentos
+static const size_t JIT_MAX_INSTRUCTIONS = 1u << 22;
+
+bool JitProgram::supported() {
+#ifdef JIT_X86_64
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef JIT_X86_64
+
+namespace {
+
+enum Register {
+    RAX = 0, RCX = 1, RDX = 2, RBX = 3, RSP = 4, RBP = 5, RSI = 6, RDI = 7,
+    R8 = 8, R9 = 9, R10 = 10, R11 = 11, R12 = 12, R13 = 13, R14 = 14, R15 = 15
+};
+
+// rdi aponta para varWords e rsi para a área de derramamento; os salvos
+// pelo chamado (rbx, rbp, r12-r15) ficam por último
+const int ALLOCATABLE[] = { RAX, RCX, RDX, R8, R9, R10, R11, RBX, RBP, R12, R13, R14, R15 };
+const int NUM_ALLOCATABLE = sizeof(ALLOCATABLE) / sizeof(ALLOCATABLE[0]);
+
+bool isCalleeSaved(int reg) {
+    return reg == RBX || reg == RBP || reg >= R12;
+}
+
+// Registrador ou palavra em [base + disp]
+struct Operand {
+    bool inMemory;
+    int reg;
+    int base;
+    int32_t disp;
+
+    static Operand inRegister(int r) {
+        Operand op = { false, r, 0, 0 };
+        return op;
+    }
+    static Operand at(int base, int32_t disp) {
+        Operand op = { true, -1, base, disp };
+        return op;
+    }
+};
+
+// Codificação das poucas instruções de 64 bits que o gerador usa
+class Assembler {
+public:
+    std::vector<uint8_t> code;
+
+    // op reg, r/m (mov 8B, and 23, or 0B)
+    void binary(uint8_t opcode, int reg, const Operand& src) {
+        int rm = src.inMemory ? src.base : src.reg;
+        rex(reg, rm);
+        code.push_back(opcode);
+        modrm(reg, src);
+    }
+
+    void load(int reg, const Operand& src) {
+        if (!src.inMemory && src.reg == reg) return;
+        binary(0x8B, reg, src);
+    }
+
+    void store(const Operand& dst, int reg) {
+        rex(reg, dst.base);
+        code.push_back(0x89);
+        modrm(reg, dst);
+    }
+
+    void bitwiseNot(int reg) {
+        rex(0, reg);
+        code.push_back(0xF7);
+        code.push_back(static_cast<uint8_t>(0xD0 | (reg & 7)));   // /2
+    }
+
+    void allOnes(int reg) {
+        // or reg, -1
+        rex(0, reg);
+        code.push_back(0x83);
+        code.push_back(static_cast<uint8_t>(0xC8 | (reg & 7)));   // /1
+        code.push_back(0xFF);
+    }
+
+    void push(int reg) {
+        if (reg >= 8) code.push_back(0x41);
+        code.push_back(static_cast<uint8_t>(0x50 | (reg & 7)));
+    }
+
+    void pop(int reg) {
+        if (reg >= 8) code.push_back(0x41);
+        code.push_back(static_cast<uint8_t>(0x58 | (reg & 7)));
+    }
+
+    void ret() {
+        code.push_back(0xC3);
+    }
+
+private:
+    void rex(int reg, int rm) {
+        code.push_back(static_cast<uint8_t>(0x48 | ((reg >> 3) << 2) | (rm >> 3)));
+    }
+
+    void modrm(int reg, const Operand& op) {
+        const uint8_t r = static_cast<uint8_t>((reg & 7) << 3);
+        if (!op.inMemory) {
+            code.push_back(static_cast<uint8_t>(0xC0 | r | (op.reg & 7)));
+            return;
+        }
+        // As bases são sempre rdi ou rsi: sem SIB e sem o caso especial de rbp
+        if (op.disp >= -128 && op.disp <= 127) {
+            code.push_back(static_cast<uint8_t>(0x40 | r | (op.base & 7)));
+            code.push_back(static_cast<uint8_t>(op.disp));
+        } else {
+            code.push_back(static_cast<uint8_t>(0x80 | r | (op.base & 7)));
+            uint32_t disp = static_cast<uint32_t>(op.disp);
+            for (int i = 0; i < 4; ++i) {
+                code.push_back(static_cast<uint8_t>(disp >> (8 * i)));
+            }
+        }
+    }
+};
+
+// Gera o corpo da função em uma passada sobre o programa
+class CodeGenerator {
+private:
+    const std::vector<BitSliceInstruction>& program;
+    std::vector<size_t> lastUse;
+    std::vector<Operand> home;      // Onde está o valor de cada slot
+    int occupant[16];               // Slot em cada registrador (-1 = livre)
+    bool touched[16];
+
+public:
+    Assembler body;
+
+    explicit CodeGenerator(const std::vector<BitSliceInstruction>& p) : program(p) {
+        for (int r = 0; r < 16; ++r) {
+            occupant[r] = -1;
+            touched[r] = false;
+        }
+    }
+
+    bool usedRegister(int reg) const { return touched[reg]; }
+
+    void generate() {
+        const size_t size = program.size();
+        lastUse.assign(size, 0);
+        for (size_t i = 0; i < size; ++i) {
+            const BitSliceInstruction& inst = program[i];
+            if (inst.type == NodeType::VARIABLE) continue;
+            lastUse[inst.left] = i;
+            if (inst.right >= 0) lastUse[inst.right] = i;
+        }
+        lastUse[size - 1] = size;   // A raiz é o valor de retorno
+
+        home.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            emitInstruction(i);
+        }
+
+        body.load(RAX, home[size - 1]);
+        touched[RAX] = true;
+    }
+
+private:
+    bool diesAt(int slot, size_t i) const {
+        return !home[slot].inMemory && lastUse[slot] == i;
+    }
+
+    // Registrador livre; sem nenhum, derrama o valor vivo usado mais tarde
+    int allocate(const Operand& a, const Operand& b) {
+        for (int k = 0; k < NUM_ALLOCATABLE; ++k) {
+            if (occupant[ALLOCATABLE[k]] < 0) return take(ALLOCATABLE[k]);
+        }
+
+        int victim = -1;
+        for (int k = 0; k < NUM_ALLOCATABLE; ++k) {
+            int reg = ALLOCATABLE[k];
+            if ((!a.inMemory && a.reg == reg) || (!b.inMemory && b.reg == reg)) continue;
+            if (victim < 0 || lastUse[occupant[reg]] > lastUse[occupant[victim]]) victim = reg;
+        }
+
+        int slot = occupant[victim];
+        home[slot] = Operand::at(RSI, static_cast<int32_t>(slot * sizeof(uint64_t)));
+        body.store(home[slot], victim);
+        occupant[victim] = -1;
+        return take(victim);
+    }
+
+    int take(int reg) {
+        touched[reg] = true;
+        return reg;
+    }
+
+    void emitInstruction(size_t i) {
+        const BitSliceInstruction& inst = program[i];
+        if (inst.type == NodeType::VARIABLE) {
+            home[i] = Operand::at(RDI, static_cast<int32_t>(inst.left * sizeof(uint64_t)));
+            return;
+        }
+
+        const bool binaryOp = inst.type != NodeType::NOT;
+        int left = inst.left;
+        int right = binaryOp ? inst.right : inst.left;
+        const bool commutative = inst.type == NodeType::AND || inst.type == NodeType::OR;
+
+        // O destino reaproveita o registrador de um operando que morre aqui
+        int dst;
+        if (diesAt(left, i)) {
+            dst = home[left].reg;
+        } else if (binaryOp && commutative && diesAt(right, i)) {
+            std::swap(left, right);
+            dst = home[left].reg;
+        } else {
+            dst = allocate(home[left], home[right]);
+        }
+
+        const Operand src = home[left];
+        const Operand other = home[right];
+        body.load(dst, src);
+        switch (inst.type) {
+            case NodeType::NOT:
+                body.bitwiseNot(dst);
+                break;
+            case NodeType::AND:
+                body.binary(0x23, dst, other);
+                break;
+            case NodeType::OR:
+                body.binary(0x0B, dst, other);
+                break;
+            case NodeType::IMPLIES:
+                // ¬p ∨ q; com p = q (a mesma subfórmula) o valor é constante
+                if (left == right) {
+                    body.allOnes(dst);
+                } else {
+                    body.bitwiseNot(dst);
+                    body.binary(0x0B, dst, other);
+                }
+                break;
+            default:
+                break;
+        }
+
+        if (diesAt(left, i)) occupant[home[left].reg] = -1;
+        if (binaryOp && diesAt(right, i)) occupant[home[right].reg] = -1;
+        occupant[dst] = static_cast<int>(i);
+        home[i] = Operand::inRegister(dst);
+    }
+};
+
+} // namespace
+
+bool JitProgram::compile(const std::vector<BitSliceInstruction>& program) {
+    release();
+    if (program.empty() || program.size() > JIT_MAX_INSTRUCTIONS) return false;
+
+    CodeGenerator generator(program);
+    generator.generate();
+
+    // Prólogo e epílogo salvam só os registradores preservados que o corpo usa
+    Assembler function;
+    std::vector<int> saved;
+    for (int k = 0; k < NUM_ALLOCATABLE; ++k) {
+        if (isCalleeSaved(ALLOCATABLE[k]) && generator.usedRegister(ALLOCATABLE[k])) {
+            saved.push_back(ALLOCATABLE[k]);
+            function.push(ALLOCATABLE[k]);
+        }
+    }
+    function.code.insert(function.code.end(), generator.body.code.begin(), generator.body.code.end());
+    for (size_t k = saved.size(); k-- > 0;) {
+        function.pop(saved[k]);
+    }
+    function.ret();
+
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t length = (function.code.size() + page - 1) / page * page;
+    void* block = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (block == MAP_FAILED) return false;
+
+    std::memcpy(block, function.code.data(), function.code.size());
+    if (mprotect(block, length, PROT_READ | PROT_EXEC) != 0) {
+        munmap(block, length);
+        return false;
+    }
+
+    memory = block;
+    mappedSize = length;
+    codeBytes = function.code.size();
+    entry = reinterpret_cast<WordFn>(block);
+    return true;
+}
+
+void JitProgram::release() {
+    if (memory != nullptr) {
+        munmap(memory, mappedSize);
+    }
+    memory = nullptr;
+    mappedSize = 0;
+    codeBytes = 0;
+    entry = nullptr;
+}
+
+#else
+
+bool JitProgram::compile(const std::vector<BitSliceInstruction>&) {
+    return false;
+}
+
+void JitProgram::release() {
+    entry = nullptr;
+}
+
+#endif
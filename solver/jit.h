@@ -0,0 +1,50 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include "simd.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Compilador do programa bit-sliced para código nativo x86-64 (System V).
+// Cada instrução vira uma ou duas operações de 64 bits em linha reta, sem
+// despacho: os valores vivos ficam nos 13 registradores de uso geral
+// disponíveis e, quando eles acabam, o que tem o último uso mais distante é
+// derramado para a memória. Variáveis são lidas direto de varWords como
+// operandos de memória. O código é escrito em uma página obtida com mmap e
+// depois marcada como executável (nunca escrita e executável ao mesmo tempo).
+class JitProgram {
+public:
+    // Avalia uma palavra: varWords[i] é a palavra da variável i e spill tem
+    // uma entrada por instrução do programa. Devolve a palavra da raiz.
+    typedef uint64_t (*WordFn)(const uint64_t* varWords, uint64_t* spill);
+
+private:
+    WordFn entry;
+    void* memory;
+    size_t mappedSize;
+    size_t codeBytes;
+
+    void release();
+
+public:
+    JitProgram() : entry(nullptr), memory(nullptr), mappedSize(0), codeBytes(0) {}
+    ~JitProgram() { release(); }
+
+    JitProgram(const JitProgram&) = delete;
+    JitProgram& operator=(const JitProgram&) = delete;
+
+    // Plataforma com gerador de código (x86-64 fora do Windows)
+    static bool supported();
+
+    // Gera o código do programa; false se não há suporte ou a página
+    // executável não pôde ser criada (o chamador volta ao interpretador)
+    bool compile(const std::vector<BitSliceInstruction>& program);
+
+    bool ready() const { return entry != nullptr; }
+    size_t size() const { return codeBytes; }
+
+    uint64_t run(const uint64_t* varWords, uint64_t* spill) const { return entry(varWords, spill); }
+};
+
+#endif
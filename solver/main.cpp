@@ -1,115 +1,105 @@
 #include "../common/ast.h"
 #include "../common/utils.h"
+#include "../common/instance_reader.h"
+#include "../common/binary_instances.h"
 #include "parser.h"
 #include "evaluator.h"
+#include "bitslice.h"
+#include "parallel.h"
+#include "compiled.h"
+#include "incremental.h"
+#include "tseitin.h"
+#include "bdd.h"
+#include "shannon.h"
+#include "simplifier.h"
+#include "decompose.h"
+#include "batch.h"
+#include "deadline.h"
+#include "bigcount.h"
+#include "result_cache.h"
+#include "canonical.h"
+#include "perf_counters.h"
+#include "report.h"
 #include <iostream>
 #include <chrono>
 #include <iomanip>
 #include <cstring>
 #include <algorithm>
 #include <fstream>
+#include <sstream>
 #include <cmath>
-#include <signal.h>
-#include <unistd.h>
-#include <setjmp.h>
-
-// Global variables for timeout handling
-static jmp_buf timeout_jump;
-static bool timeout_occurred = false;
-static int timeout_seconds = 30; // Default timeout
-
-void timeout_handler(int sig) {
-    timeout_occurred = true;
-    longjmp(timeout_jump, 1);
-}
-
-class TimeoutEvaluator : public Evaluator {
-private:
-    std::chrono::high_resolution_clock::time_point start_time;
-    int timeout_ms;
-    
-public:
-    TimeoutEvaluator(int timeout_milliseconds = 30000) : timeout_ms(timeout_milliseconds) {}
-    
-    bool isTautologyWithTimeout(std::shared_ptr<ASTNode> root, const std::vector<std::string>& variables) {
-        resetMetrics();
-        start_time = std::chrono::high_resolution_clock::now();
-        
-
-        signal(SIGALRM, timeout_handler);
-        timeout_occurred = false;
-        
-        alarm(timeout_seconds);
-        
-        if (setjmp(timeout_jump) != 0) {
-            alarm(0);
-            throw std::runtime_error("TIMEOUT: Formula evaluation exceeded " + std::to_string(timeout_seconds) + " seconds");
-        }
-        
-        try {
-            auto truthTable = FileUtils::generateTruthTable(variables.size());
-            
-            for (const auto& row : truthTable) {
-                auto current_time = std::chrono::high_resolution_clock::now();
-                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(current_time - start_time);
-                
-                if (elapsed.count() > timeout_ms) {
-                    alarm(0); 
-                    throw std::runtime_error("TIMEOUT: Formula evaluation exceeded " + std::to_string(timeout_ms) + " milliseconds");
-                }
-                
-                std::unordered_map<std::string, bool> currentAssignment;
-                for (size_t i = 0; i < variables.size(); ++i) {
-                    currentAssignment[variables[i]] = row[i];
-                }
-                
-                setAssignment(currentAssignment);
-                
-                if (!evaluate(root)) {
-                    alarm(0);
-                    return false;
-                }
-            }
-            
-            alarm(0);
-            return true;
-            
-        } catch (...) {
-            alarm(0); 
-            throw;
-        }
-    }
-};
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <memory>
 
 class PerformanceMonitor {
 private:
     std::chrono::high_resolution_clock::time_point startTime;
     long long lastExecutionTime;
+    std::ostream* out;
+    const PhaseProfile* profile;
+    InstanceReport* report;     // Registro da saída estruturada; nullptr no formato texto
     
 public:
+    PerformanceMonitor(std::ostream& output = std::cout, InstanceReport* record = nullptr)
+        : lastExecutionTime(0), out(&output), profile(nullptr), report(record) {}
+    
+    // Medidas por fase (--perf-counters) impressas no bloco de resultado
+    void setProfile(const PhaseProfile* phases) {
+        profile = phases;
+    }
+    
     void start() {
         startTime = std::chrono::high_resolution_clock::now();
     }
     
-    void stop(const std::string& filename, bool isTautology, const Evaluator::Metrics& metrics, bool timedOut = false) {
+    // models é a linha da contagem de modelos (--count), se houver
+    void stop(const std::string& filename, bool isTautology, const Evaluator::Metrics& metrics, bool timedOut = false,
+              const std::string& models = std::string()) {
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
         lastExecutionTime = duration.count();
         
-        std::cout << "=== RESULTADO ===" << std::endl;
-        std::cout << "Instância: " << filename << std::endl;
+        if (report != nullptr) {
+            report->id = filename;
+            report->status = timedOut ? SolveStatus::TIMED_OUT
+                                      : (isTautology ? SolveStatus::TAUTOLOGY : SolveStatus::NOT_TAUTOLOGY);
+            report->timeMicros = lastExecutionTime;
+            report->metrics = metrics;
+            report->models = timedOut ? std::string() : models;
+            if (profile != nullptr) {
+                report->setProfile(*profile);
+            }
+            return;
+        }
+        
+        *out << "=== RESULTADO ===" << std::endl;
+        *out << "Instância: " << filename << std::endl;
         
         if (timedOut) {
-            std::cout << "Status: TIMEOUT - Não foi possível determinar em tempo hábil" << std::endl;
+            *out << "Status: TIMEOUT - Não foi possível determinar em tempo hábil" << std::endl;
         } else {
-            std::cout << "É tautologia: " << (isTautology ? "SIM" : "NÃO") << std::endl;
+            *out << "É tautologia: " << (isTautology ? "SIM" : "NÃO") << std::endl;
+            if (!models.empty()) {
+                *out << "Modelos: " << models << std::endl;
+            }
         }
         
-        std::cout << "Tempo de execução: " << duration.count() << " μs" << std::endl;
-        std::cout << "Avaliações realizadas: " << metrics.evaluations << std::endl;
-        std::cout << "Operações na pilha: " << metrics.stackOperations << std::endl;
-        std::cout << "Tamanho máximo da pilha: " << metrics.maxStackSize << std::endl;
-        std::cout << "=================" << std::endl << std::endl;
+        *out << "Tempo de execução: " << duration.count() << " μs" << std::endl;
+        if (metrics.compileTime > 0) {
+            *out << "Tempo de compilação (JIT): " << metrics.compileTime << " μs" << std::endl;
+            *out << "Tempo de varredura: " << std::max(0LL, static_cast<long long>(duration.count()) - metrics.compileTime)
+                 << " μs" << std::endl;
+        }
+        *out << "Avaliações realizadas: " << metrics.evaluations << std::endl;
+        *out << "Operações na pilha: " << metrics.stackOperations << std::endl;
+        *out << "Tamanho máximo da pilha: " << metrics.maxStackSize << std::endl;
+        if (profile != nullptr) {
+            profile->print(*out);
+        }
+        *out << "=================" << std::endl << std::endl;
     }
     
     long long getLastExecutionTime() const {
@@ -117,96 +107,633 @@ public:
     }
 };
 
+// Configuração dos motores de avaliação escolhida na linha de comando
+struct SolverOptions {
+    std::string engine;
+    std::string simd;
+    bool jit;
+    int threads;
+    bool shareSubterms;
+    bool simplify;
+    bool decompose;
+    std::string bddOrder;
+    size_t bddNodeLimit;
+    int jobs;
+    bool count;
+    ResultCache* cache;         // nullptr sem --cache
+    bool dedup;
+    EquivalenceGroups* groups;  // Instâncias equivalentes do modo -a; nullptr fora dele
+    bool perfCounters;
+    OutputFormat format;
+    
+    SolverOptions() : engine("bruteforce"), simd("auto"), jit(true), threads(1), shareSubterms(true), simplify(true), decompose(true),
+                      bddOrder("appearance"), bddNodeLimit(4000000), jobs(1), count(false), cache(nullptr),
+                      dedup(true), groups(nullptr), perfCounters(false), format(OutputFormat::TEXT) {}
+};
+
+// Motores que, além do veredito, produzem uma atribuição falsificadora
+bool reportsCounterexample(const std::string& engine) {
+    return engine == "sat" || engine == "bdd" || engine == "shannon";
+}
+
+// Motores que enumeram as 2^n linhas da tabela-verdade em um contador de 64 bits
+bool enumeratesRows(const std::string& engine) {
+    return !reportsCounterexample(engine);
+}
+
+// A partir daqui a tabela-verdade não cabe no contador dos motores de enumeração
+const size_t MAX_ENUMERATED_VARIABLES = 63;
+
+// Atribuição que falsifica a fórmula, no formato "a=1, b=0"
+std::string formatCounterexample(const AST& ast, const std::vector<bool>& model) {
+    std::string text;
+    for (size_t v = 0; v < model.size(); ++v) {
+        text += ast.variableName(static_cast<uint32_t>(v)) + (model[v] ? "=1" : "=0");
+        if (v + 1 < model.size()) text += ", ";
+    }
+    return text;
+}
+
+void printCounterexample(std::ostream& out, const AST& ast, const std::vector<bool>& model) {
+    out << "Contraexemplo: " << formatCounterexample(ast, model) << std::endl;
+}
+
 void printUsage() {
     std::cout << "Uso: ./solver_timeout <arquivo> [opcoes]" << std::endl;
     std::cout << "  arquivo: Caminho para arquivo de fórmula ou instâncias" << std::endl;
     std::cout << "Opções:" << std::endl;
     std::cout << "  -t, --timeout SECONDS: Define timeout em segundos (padrão: 30)" << std::endl;
+    std::cout << "  --batch-timeout SECONDS: Tempo total do modo -a; ao esgotar, as instâncias restantes dão timeout (0 = sem limite; padrão: 0)" << std::endl;
     std::cout << "  -i, --instance ID: Testa apenas a instância com ID específico" << std::endl;
     std::cout << "  -a, --all: Testa todas as instâncias do arquivo" << std::endl;
     std::cout << "  -v, --verbose: Mostra informações detalhadas" << std::endl;
     std::cout << "  -d, --debug: Mostra a árvore de sintaxe" << std::endl;
     std::cout << "  -s, --summary: Mostra apenas resumo" << std::endl;
+    std::cout << "  -e, --engine NOME: Motor de avaliação (bruteforce, bitslice, compiled, gray, sat, bdd, shannon; padrão: bruteforce)" << std::endl;
+    std::cout << "  --simd KERNEL: Kernel do bitslice (auto, scalar, avx2, avx512; padrão: auto)" << std::endl;
+    std::cout << "  --threads N: Threads na varredura da tabela verdade (0 = todos os núcleos; padrão: 1)" << std::endl;
+    std::cout << "  --jobs N: Instâncias resolvidas em paralelo no modo -a (0 = todos os núcleos; padrão: 1)" << std::endl;
+    std::cout << "  --bdd-order ORDEM: Ordenação das variáveis do BDD (appearance, alpha, sift; padrão: appearance)" << std::endl;
+    std::cout << "  --bdd-limit N: Limite de nós do BDD; acima dele usa o motor sat (0 = sem limite; padrão: 4000000)" << std::endl;
+    std::cout << "  --no-jit: O bitslice não gera código nativo; usa sempre os kernels interpretados" << std::endl;
+    std::cout << "  --no-share: Não compartilha subfórmulas idênticas (AST em árvore em vez de DAG)" << std::endl;
+    std::cout << "  --no-simplify: Não reescreve a fórmula antes da avaliação" << std::endl;
+    std::cout << "  --no-decompose: Não divide a conjunção do topo em termos independentes" << std::endl;
+    std::cout << "  --cache DIR: Guarda e reaproveita resultados em DIR entre execuções" << std::endl;
+    std::cout << "  --cache-size MB: Tamanho máximo do cache; os menos usados são removidos (padrão: 64)" << std::endl;
+    std::cout << "  --no-dedup: No modo -a, resolve também as instâncias equivalentes a uma anterior" << std::endl;
+    std::cout << "  --perf-counters: Mede cada fase (parse, variáveis, simplificação, compilação, varredura) com" << std::endl;
+    std::cout << "                   tempo, ciclos, instruções, cache misses, branch misses e pico de RSS" << std::endl;
+    std::cout << "  --format FORMATO: Saída de cada instância (text, jsonl, csv; padrão: text). Em jsonl e csv só os" << std::endl;
+    std::cout << "                    registros vão para a saída padrão; avisos, -v e o resumo vão para a saída de erro" << std::endl;
+    std::cout << "  --count: Conta as atribuições que satisfazem a fórmula em vez de parar no primeiro contraexemplo" << std::endl;
     std::cout << "  -h, --help: Mostra esta mensagem" << std::endl;
     std::cout << std::endl;
     std::cout << "Exemplos:" << std::endl;
     std::cout << "  ./solver_timeout formula.txt -t 60 -v    # Timeout de 60 segundos" << std::endl;
     std::cout << "  ./solver_timeout instances.txt -a -t 10  # Timeout de 10 segundos para todas" << std::endl;
+    std::cout << "  ./solver_timeout instances.txt -a -e bitslice  # 64 atribuições por palavra" << std::endl;
+    std::cout << "  ./solver_timeout instances.txt -a --jobs 0     # Uma instância por núcleo" << std::endl;
+    std::cout << "  ./solver_timeout instances.txt -a --format jsonl > resultados.jsonl" << std::endl;
+}
+
+// Resultado de um motor sobre uma fórmula
+struct EngineRun {
+    bool isTautology;
+    Evaluator::Metrics metrics;
+    std::vector<bool> counterexample;   // Vazio se o motor não produz contraexemplo
+    std::string engine;                 // Motor que decidiu, depois de qualquer fallback
+
+    EngineRun() : isTautology(false) {}
+};
+
+// Executa o motor escolhido. Com concurrent = true a chamada vem de uma
+// thread auxiliar e cada motor roda com uma única thread.
+EngineRun runEngine(std::ostream& out, const AST& ast, const SolverOptions& options, const Deadline& deadline,
+                    bool verbose, bool debug, bool concurrent) {
+    EngineRun run;
+    run.engine = options.engine;
+    const int threads = concurrent ? 1 : options.threads;
+
+    // Um prazo que já expirou (por exemplo, o orçamento do lote) nem começa
+    deadline.check();
+
+    // Fórmulas com variáveis demais para enumerar são decididas pelo solver SAT
+    if (ast.numVariables() > MAX_ENUMERATED_VARIABLES && enumeratesRows(options.engine)) {
+        out << "AVISO: " << ast.numVariables() << " variáveis não cabem na enumeração do motor "
+            << options.engine << "; usando o motor sat" << std::endl;
+        SolverOptions fallback = options;
+        fallback.engine = "sat";
+        return runEngine(out, ast, fallback, deadline, verbose, debug, concurrent);
+    }
+
+    if (options.engine == "bitslice") {
+        BitSliceEvaluator evaluator(&deadline);
+        evaluator.setKernel(SimdDispatch::byName(options.simd));
+        evaluator.setThreads(threads);
+        evaluator.setJit(options.jit);
+        if (verbose) {
+            out << "Kernel SIMD: " << evaluator.getKernel().name << std::endl;
+        }
+        run.isTautology = evaluator.isTautology(ast);
+        run.metrics = evaluator.metrics;
+        if (verbose && evaluator.usedJit()) {
+            out << "JIT: " << evaluator.jitCodeSize() << " bytes de código x86-64" << std::endl;
+        }
+    } else if (options.engine == "compiled") {
+        CompiledFormula program(ast);
+        if (debug) {
+            out << "=== PROGRAMA COMPILADO (" << program.size() << " instruções) ===" << std::endl;
+            program.print(out);
+            out << "========================\n" << std::endl;
+        }
+        CompiledEvaluator evaluator(&deadline);
+        evaluator.setThreads(threads);
+        run.isTautology = evaluator.isTautology(program);
+        run.metrics = evaluator.metrics;
+    } else if (options.engine == "gray") {
+        IncrementalEvaluator evaluator(&deadline);
+        evaluator.setThreads(threads);
+        run.isTautology = evaluator.isTautology(ast);
+        run.metrics = evaluator.metrics;
+    } else if (options.engine == "sat") {
+        SatEvaluator evaluator(&deadline);
+        run.isTautology = evaluator.isTautology(ast);
+        run.metrics = evaluator.metrics;
+        run.counterexample = evaluator.counterexample();
+        if (verbose) {
+            out << "Cláusulas: " << evaluator.numClauses
+                      << ", conflitos: " << evaluator.stats.conflicts
+                      << ", reinícios: " << evaluator.stats.restarts
+                      << ", cláusulas aprendidas: " << evaluator.stats.learnedClauses
+                      << " (removidas: " << evaluator.stats.deletedClauses << ")" << std::endl;
+        }
+    } else if (options.engine == "shannon") {
+        ShannonEvaluator evaluator(&deadline);
+        run.isTautology = evaluator.isTautology(ast);
+        run.metrics = evaluator.metrics;
+        run.counterexample = evaluator.counterexample();
+    } else if (options.engine == "bdd") {
+        BddEvaluator evaluator(&deadline);
+        evaluator.setOrdering(options.bddOrder);
+        evaluator.setNodeLimit(options.bddNodeLimit);
+        try {
+            run.isTautology = evaluator.isTautology(ast);
+            run.metrics = evaluator.metrics;
+            run.counterexample = evaluator.counterexample();
+            if (verbose) {
+                out << "Nós no BDD: " << evaluator.bddSize
+                          << ", pico de nós vivos: " << evaluator.stats.peakNodes
+                          << ", acertos no cache: " << evaluator.stats.cacheHits
+                          << ", coletas de lixo: " << evaluator.stats.gcRuns
+                          << ", reordenações: " << evaluator.stats.reorderings << std::endl;
+            }
+        } catch (const BddLimitExceeded& e) {
+            // BDD grande demais para esta ordem: decide pelo solver SAT
+            out << "AVISO: " << e.what() << "; usando o motor sat" << std::endl;
+            SatEvaluator fallback(&deadline);
+            run.engine = "sat";
+            run.isTautology = fallback.isTautology(ast);
+            run.metrics = fallback.metrics;
+            run.counterexample = fallback.counterexample();
+        }
+    } else {
+        Evaluator evaluator;
+        run.isTautology = (threads == 1) ? evaluator.isTautology(ast, &deadline)
+                                         : evaluator.isTautologyParallel(ast, threads, &deadline);
+        run.metrics = evaluator.metrics;
+    }
+
+    return run;
 }
 
-void testFormulaWithTimeout(const std::string& formula, const std::string& id, const std::string& type, 
-                           bool verbose, bool debug, PerformanceMonitor& monitor, int timeoutSeconds) {
+// Até aqui a contagem varre a tabela-verdade inteira; acima, conta sobre o BDD
+const size_t COUNT_ENUMERATION_LIMIT = 24;
+
+// Conta as atribuições de numVars variáveis que satisfazem a fórmula. ast é
+// a fórmula já simplificada: as variáveis que a simplificação eliminou não
+// afetam o valor e multiplicam a contagem por 2. models recebe a contagem
+// formatada para o relatório.
+EngineRun runCounter(std::ostream& out, const AST& ast, Simplifier::Outcome outcome, size_t numVars,
+                     const SolverOptions& options, const Deadline& deadline, bool verbose, bool concurrent,
+                     std::string& models) {
+    EngineRun run;
+    run.engine = "simplifier";
+    deadline.check();
+
+    const BigCount all = BigCount::powerOfTwo(static_cast<uint32_t>(numVars));
+    BigCount count;
+    if (outcome == Simplifier::CONSTANT_TRUE) {
+        count = all;
+    } else if (outcome == Simplifier::FORMULA) {
+        bool enumerate = ast.numVariables() <= COUNT_ENUMERATION_LIMIT;
+        if (!enumerate) {
+            BddEvaluator evaluator(&deadline);
+            evaluator.setOrdering(options.bddOrder);
+            evaluator.setNodeLimit(options.bddNodeLimit);
+            try {
+                count = evaluator.countModels(ast);
+                run.metrics = evaluator.metrics;
+                run.engine = "bdd";
+                if (verbose) {
+                    out << "Contagem: BDD com " << evaluator.bddSize << " nós" << std::endl;
+                }
+            } catch (const BddLimitExceeded& e) {
+                if (ast.numVariables() > MAX_ENUMERATED_VARIABLES) throw;
+                out << "AVISO: " << e.what() << "; contando por enumeração" << std::endl;
+                enumerate = true;
+            }
+        }
+        if (enumerate) {
+            BitSliceEvaluator evaluator(&deadline);
+            evaluator.setKernel(SimdDispatch::byName(options.simd));
+            evaluator.setThreads(concurrent ? 1 : options.threads);
+            evaluator.setJit(options.jit);
+            count = BigCount(evaluator.countModels(ast));
+            run.metrics = evaluator.metrics;
+            run.engine = "bitslice";
+            if (verbose) {
+                out << "Contagem: enumeração bit-sliced ("
+                    << (evaluator.usedJit() ? std::string("JIT") : "kernel " + std::string(evaluator.getKernel().name))
+                    << ")" << std::endl;
+            }
+        }
+        count.shiftLeft(static_cast<uint32_t>(numVars - ast.numVariables()));
+    }
+
+    run.isTautology = (count == all);
+
+    std::ostringstream text;
+    text << count.toString() << " de 2^" << numVars << " (" << std::fixed << std::setprecision(4)
+         << 100.0 * count.ratio(static_cast<uint32_t>(numVars)) << "%)";
+    models = text.str();
+    return run;
+}
+
+// Verifica os termos de uma conjunção, parando no primeiro que não é
+// tautologia. Com --threads diferente de 1 os termos são distribuídos entre
+// as threads (cada motor roda com uma thread só). Todos os termos dividem o
+// mesmo prazo.
+EngineRun runConjuncts(std::ostream& out, const std::vector<AST>& parts, const AST& whole,
+                       const SolverOptions& options, const Deadline& deadline, bool concurrent) {
+
+    EngineRun total;
+    total.isTautology = true;
+    total.engine = options.engine;
+    auto merge = [&](const EngineRun& run, const AST& part) {
+        if (run.engine != options.engine) total.engine = run.engine;
+        total.metrics.evaluations += run.metrics.evaluations;
+        total.metrics.stackOperations += run.metrics.stackOperations;
+        total.metrics.compileTime += run.metrics.compileTime;
+        total.metrics.maxStackSize = std::max(total.metrics.maxStackSize, run.metrics.maxStackSize);
+        if (!run.isTautology && total.isTautology) {
+            total.isTautology = false;
+            if (!run.counterexample.empty()) {
+                total.counterexample = ConjunctDecomposer::liftAssignment(part, run.counterexample, whole);
+            }
+        }
+    };
+
+    const int numThreads = std::min<int>(ParallelSweep::resolveThreads(options.threads), parts.size());
+    if (numThreads <= 1) {
+        for (const auto& part : parts) {
+            merge(runEngine(out, part, options, deadline, false, false, concurrent), part);
+            if (!total.isTautology) break;
+        }
+        return total;
+    }
+
+    // Quando um termo falha, os que ainda estão rodando são cancelados
+    Deadline terms(0, &deadline);
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::mutex lock;
+    std::exception_ptr error;
+
+    auto worker = [&]() {
+        while (!failed.load()) {
+            size_t i = next.fetch_add(1);
+            if (i >= parts.size()) return;
+            try {
+                EngineRun run = runEngine(out, parts[i], options, terms, false, false, true);
+                std::lock_guard<std::mutex> guard(lock);
+                merge(run, parts[i]);
+                if (!run.isTautology) {
+                    failed.store(true);
+                    terms.cancel();
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(lock);
+                if (!error) error = std::current_exception();
+                failed.store(true);
+                terms.cancel();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < numThreads; ++t) {
+        pool.push_back(std::thread(worker));
+    }
+    for (auto& t : pool) {
+        t.join();
+    }
+
+    // Um termo falso decide a fórmula mesmo que outro tenha estourado o prazo
+    if (error && total.isTautology) {
+        std::rethrow_exception(error);
+    }
+    return total;
+}
+
+// Toda a saída vai para out; concurrent indica que outras instâncias estão
+// sendo resolvidas ao mesmo tempo em outras threads. O prazo da instância
+// é limitado também por batch, se houver. Com compiled (arquivo binário)
+// a AST já vem pronta e formula não é analisada. Com report (--format jsonl
+// ou csv) o resultado vai para o registro em vez do bloco de texto, e out
+// recebe só os avisos e as mensagens de -v e -d.
+SolveStatus testFormulaWithTimeout(std::ostream& out, const std::string& formula, const std::string& id,
+                                   const std::string& type, bool verbose, bool debug, int timeoutSeconds,
+                                   const SolverOptions& options, bool concurrent, const Deadline* batch,
+                                   InstanceReport* report, const AST* compiled = nullptr) {
+    PerformanceMonitor monitor(out, report);
+    const bool text = report == nullptr;
+    if (report != nullptr) {
+        report->id = id;
+        report->expected = type;
+        report->engine = options.engine;
+    }
     
     if (verbose) {
-        std::cout << "\n=== TESTANDO FÓRMULA " << id << " ===" << std::endl;
-        std::cout << "Fórmula: " << formula << std::endl;
-        std::cout << "Timeout configurado: " << timeoutSeconds << " segundos" << std::endl;
+        out << "\n=== TESTANDO FÓRMULA " << id << " ===" << std::endl;
+        out << "Fórmula: " << (compiled != nullptr ? compiled->toString() : formula) << std::endl;
+        out << "Timeout configurado: " << timeoutSeconds << " segundos" << std::endl;
+        out << "Motor: " << options.engine << std::endl;
+        if (options.threads != 1) {
+            out << "Threads: " << ParallelSweep::resolveThreads(options.threads) << std::endl;
+        }
         if (!type.empty()) {
-            std::cout << "Tipo esperado: " << type << std::endl;
+            out << "Tipo esperado: " << type << std::endl;
         }
     }
     
+    // Posse do grupo de instâncias equivalentes, publicada com o veredito
+    EquivalenceGroups::Claim claim;
+    
+    // Contadores por fase (--perf-counters), só desta thread e das que ela criar
+    std::unique_ptr<PhaseProfile> profile;
+    if (options.perfCounters) {
+        profile.reset(new PhaseProfile());
+        monitor.setProfile(profile.get());
+    }
+    ActiveProfile activeProfile(profile.get());
+    
     try {
         // Parse da fórmula
-        Parser parser(formula);
-        auto ast = parser.parse();
+        AST ast;
+        {
+            PhaseScope phase(SolverPhase::PARSE);
+            if (compiled != nullptr) {
+                ast = *compiled;
+            } else {
+                Parser parser(formula, options.shareSubterms);
+                ast = parser.parse();
+            }
+        }
+        
+        // IDs em ordem alfabética: a primeira variável é o bit mais significativo
+        {
+            PhaseScope phase(SolverPhase::VARIABLES);
+            ast.sortVariables();
+        }
+        const size_t numVariables = ast.numVariables();
+        if (report != nullptr) {
+            report->variables = numVariables;
+            report->nodes = ast.size();
+        }
+        
+        // Compara o veredito com o tipo esperado da instância
+        auto finish = [&](bool isTautology) {
+            if (!type.empty()) {
+                bool expectedTautology = (type == "TAUTOLOGY");
+                bool consistent = type == "RANDOM" || isTautology == expectedTautology;
+                if (report != nullptr) {
+                    report->checked = true;
+                    report->consistent = consistent;
+                } else if (consistent) {
+                    out << "✓ Resultado consistente com tipo esperado!" << std::endl;
+                } else {
+                    out << "AVISO: Resultado inconsistente! Esperado: " 
+                              << (expectedTautology ? "tautologia" : "não-tautologia") 
+                              << ", obtido: " << (isTautology ? "tautologia" : "não-tautologia") << std::endl;
+                }
+            }
+            return isTautology ? SolveStatus::TAUTOLOGY : SolveStatus::NOT_TAUTOLOGY;
+        };
+        
+        // Instância equivalente a uma anterior do lote: a menos de nomes de
+        // variáveis e da ordem e do agrupamento dos operandos de ∧ e ∨
+        if (options.groups != nullptr) {
+            SharedVerdict shared;
+            if (!options.groups->join(Canonicalizer(ast).fingerprint(), claim, shared)) {
+                if (report != nullptr) {
+                    report->source = "equivalent";
+                    report->representative = shared.representative;
+                }
+                monitor.start();
+                if (shared.timedOut) {
+                    monitor.stop(id, false, Evaluator::Metrics(), true);
+                    if (text) {
+                        out << "⏰ TIMEOUT: equivalent instance " << shared.representative << " timed out" << std::endl;
+                    }
+                    return SolveStatus::TIMED_OUT;
+                }
+                monitor.stop(id, shared.isTautology, Evaluator::Metrics(), false, shared.models);
+                if (text) {
+                    out << "Resultado reaproveitado da instância " << shared.representative
+                        << " (fórmula equivalente)" << std::endl;
+                }
+                return finish(shared.isTautology);
+            }
+        }
+        
+        // Resultado de uma execução anterior (--cache). Só serve se tiver tudo
+        // o que esta execução mostraria: a contagem e o contraexemplo.
+        std::string cacheKey;
+        ResultCache::Entry cached;
+        if (options.cache != nullptr) {
+            cacheKey = ResultCache::fingerprint(ast);
+            if (options.cache->lookup(cacheKey, cached, options.count, reportsCounterexample(options.engine))) {
+                if (verbose) {
+                    out << "Resultado do cache (motor: " << cached.engine << ")" << std::endl;
+                }
+                monitor.start();
+                monitor.stop(id, cached.isTautology, Evaluator::Metrics(), false,
+                             options.count ? cached.models : std::string());
+                if (report != nullptr) {
+                    report->source = "cache";
+                    report->engine = cached.engine;
+                    if (!cached.isTautology) report->counterexample = cached.counterexample;
+                } else if (!cached.isTautology && !cached.counterexample.empty()) {
+                    out << "Contraexemplo: " << cached.counterexample << std::endl;
+                }
+                SharedVerdict verdict;
+                verdict.representative = id;
+                verdict.isTautology = cached.isTautology;
+                verdict.models = options.count ? cached.models : std::string();
+                claim.publish(verdict);
+                return finish(cached.isTautology);
+            }
+        }
+        
+        // Reescrita antes de qualquer motor; pode reduzir a fórmula a uma constante
+        Simplifier::Outcome outcome = Simplifier::FORMULA;
+        if (options.simplify) {
+            PhaseScope phase(SolverPhase::SIMPLIFY);
+            auto simplifyStart = std::chrono::high_resolution_clock::now();
+            Simplifier simplifier;
+            AST simplified;
+            outcome = simplifier.simplify(ast, simplified);
+            if (outcome == Simplifier::FORMULA) {
+                ast = simplified;
+            }
+            auto simplifyTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - simplifyStart);
+            
+            if (verbose) {
+                const Simplifier::Stats& st = simplifier.stats;
+                out << "Simplificação: "
+                          << static_cast<long long>(st.nodesBefore) - static_cast<long long>(st.nodesAfter) << " nós e "
+                          << (st.variablesBefore - st.variablesAfter) << " variáveis removidos ("
+                          << simplifyTime.count() << " μs)" << std::endl;
+                out << "  → reescritas: " << st.implications
+                          << ", duplas negações: " << st.doubleNegations
+                          << ", idempotência: " << st.idempotence
+                          << ", complementos: " << st.complements
+                          << ", absorções: " << st.absorptions
+                          << ", constantes: " << st.constants << std::endl;
+                if (outcome != Simplifier::FORMULA) {
+                    out << "Fórmula reduzida à constante "
+                              << (outcome == Simplifier::CONSTANT_TRUE ? "⊤" : "⊥") << std::endl;
+                }
+            }
+        }
         
         if (debug) {
-            std::cout << "\n=== ÁRVORE DE SINTAXE ===" << std::endl;
-            ast->print();
-            std::cout << "========================\n" << std::endl;
+            out << "\n=== ÁRVORE DE SINTAXE ===" << std::endl;
+            ast.print(out);
+            out << "========================\n" << std::endl;
         }
         
         // Coleta variáveis
         std::vector<std::string> variables;
-        ast->collectVariables(variables);
-        std::sort(variables.begin(), variables.end());
+        {
+            PhaseScope phase(SolverPhase::VARIABLES);
+            ast.collectVariables(variables);
+            std::sort(variables.begin(), variables.end());
+        }
         
         if (verbose) {
-            std::cout << "Variáveis encontradas (" << variables.size() << "): ";
+            out << "Variáveis encontradas (" << variables.size() << "): ";
             for (size_t i = 0; i < variables.size(); ++i) {
-                std::cout << variables[i];
-                if (i < variables.size() - 1) std::cout << ", ";
+                out << variables[i];
+                if (i < variables.size() - 1) out << ", ";
             }
-            std::cout << std::endl;
+            out << std::endl;
             
-            long long totalCombinations = 1LL << variables.size();
-            std::cout << "Total de combinações a testar: " << totalCombinations << std::endl;
+            out << "Total de combinações a testar: ";
+            if (variables.size() <= MAX_ENUMERATED_VARIABLES) {
+                out << (1ULL << variables.size()) << std::endl;
+            } else {
+                out << "2^" << variables.size() << std::endl;
+            }
+            out << "Nós na AST: " << ast.size() << " (" << ast.memoryUsage() << " bytes)" << std::endl;
             
             if (variables.size() > 20) {
-                std::cout << "AVISO: Fórmula com muitas variáveis (" << variables.size() 
+                out << "AVISO: Fórmula com muitas variáveis (" << variables.size() 
                           << "). Pode exceder o timeout!" << std::endl;
             }
         }
         
         // Verifica se é tautologia com timeout
+        Deadline deadline(timeoutSeconds * 1000LL, batch);
         monitor.start();
-        timeout_seconds = timeoutSeconds; // Set global timeout
-        TimeoutEvaluator evaluator(timeoutSeconds * 1000);
         
-        bool isTautology = evaluator.isTautologyWithTimeout(ast, variables);
-        monitor.stop(id, isTautology, evaluator.metrics, false);
+        // Cada termo da conjunção do topo é verificado só sobre as suas variáveis
+        std::vector<AST> parts;
+        if (outcome == Simplifier::FORMULA && options.decompose && !options.count) {
+            PhaseScope phase(SolverPhase::SIMPLIFY);
+            parts = ConjunctDecomposer::split(ast);
+            if (verbose && parts.size() > 1) {
+                out << "Decomposição: " << parts.size() << " termos independentes (maior com "
+                          << parts.back().numVariables() << " variáveis)" << std::endl;
+            }
+        }
         
-        if (!type.empty()) {
-            bool expectedTautology = (type == "TAUTOLOGY");
-            if (isTautology == expectedTautology || isTautology == (type == "RANDOM")) {
-                std::cout << "✓ Resultado consistente com tipo esperado!" << std::endl;
+        EngineRun run;
+        std::string models;
+        {
+            PhaseScope phase(SolverPhase::SWEEP);
+            if (options.count) {
+                run = runCounter(out, ast, outcome, numVariables, options, deadline, verbose, concurrent, models);
+            } else if (outcome != Simplifier::FORMULA) {
+                run.isTautology = (outcome == Simplifier::CONSTANT_TRUE);
+                run.engine = "simplifier";
+                if (!run.isTautology && reportsCounterexample(options.engine)) {
+                    run.counterexample.assign(ast.numVariables(), false);
+                }
+            } else if (parts.size() > 1) {
+                run = runConjuncts(out, parts, ast, options, deadline, concurrent);
             } else {
-                std::cout << "AVISO: Resultado inconsistente! Esperado: " 
-                          << (expectedTautology ? "tautologia" : "não-tautologia") 
-                          << ", obtido: " << (isTautology ? "tautologia" : "não-tautologia") << std::endl;
+                run = runEngine(out, ast, options, deadline, verbose, debug, concurrent);
             }
         }
+        monitor.stop(id, run.isTautology, run.metrics, false, models);
+        if (report != nullptr) {
+            report->engine = run.engine;
+            if (!run.isTautology && !run.counterexample.empty()) {
+                report->counterexample = formatCounterexample(ast, run.counterexample);
+            }
+        } else if (!run.isTautology && !run.counterexample.empty()) {
+            printCounterexample(out, ast, run.counterexample);
+        }
+        
+        if (options.cache != nullptr) {
+            ResultCache::Entry entry;
+            entry.isTautology = run.isTautology;
+            entry.engine = run.engine;
+            entry.models = models;
+            if (!run.isTautology && !run.counterexample.empty()) {
+                entry.counterexample = formatCounterexample(ast, run.counterexample);
+            }
+            // Completa a entrada incompleta que já existia, sem perder o que ela tinha
+            if (entry.models.empty()) entry.models = cached.models;
+            if (entry.counterexample.empty() && !entry.isTautology) entry.counterexample = cached.counterexample;
+            options.cache->store(cacheKey, entry);
+        }
+        
+        SharedVerdict verdict;
+        verdict.representative = id;
+        verdict.isTautology = run.isTautology;
+        verdict.models = models;
+        claim.publish(verdict);
+        
+        return finish(run.isTautology);
         
     } catch (const std::runtime_error& e) {
         std::string error_msg = e.what();
         if (error_msg.find("TIMEOUT") != std::string::npos) {
-            TimeoutEvaluator dummy_evaluator;
-            monitor.stop(id, false, dummy_evaluator.metrics, true);
-            std::cout << "⏰ " << error_msg << std::endl;
-        } else {
-            throw; 
+            monitor.stop(id, false, Evaluator::Metrics(), true);
+            if (text) {
+                out << "⏰ " << error_msg << std::endl;
+            }
+            SharedVerdict verdict;
+            verdict.representative = id;
+            verdict.timedOut = true;
+            claim.publish(verdict);
+            return SolveStatus::TIMED_OUT;
         }
+        throw;
     }
 }
 
@@ -219,15 +746,22 @@ int main(int argc, char* argv[]) {
     std::string filename = argv[1];
     std::string instanceId;
     int timeoutSeconds = 30;
+    int batchTimeoutSeconds = 0;
     bool verbose = false;
     bool debug = false;
     bool testAll = false;
     bool summaryOnly = false;
+    std::string cacheDir;
+    unsigned long cacheSizeMb = ResultCache::DEFAULT_CAPACITY / (1024 * 1024);
+    std::string format = "text";
+    SolverOptions options;
     
 
     for (int i = 2; i < argc; ++i) {
         if ((strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--timeout") == 0) && i + 1 < argc) {
             timeoutSeconds = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--batch-timeout") == 0 && i + 1 < argc) {
+            batchTimeoutSeconds = std::stoi(argv[++i]);
         } else if ((strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--instance") == 0) && i + 1 < argc) {
             instanceId = argv[++i];
         } else if (strcmp(argv[i], "-a") == 0 || strcmp(argv[i], "--all") == 0) {
@@ -238,6 +772,38 @@ int main(int argc, char* argv[]) {
             debug = true;
         } else if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--summary") == 0) {
             summaryOnly = true;
+        } else if ((strcmp(argv[i], "-e") == 0 || strcmp(argv[i], "--engine") == 0) && i + 1 < argc) {
+            options.engine = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.threads = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            options.jobs = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--no-jit") == 0) {
+            options.jit = false;
+        } else if (strcmp(argv[i], "--no-share") == 0) {
+            options.shareSubterms = false;
+        } else if (strcmp(argv[i], "--no-simplify") == 0) {
+            options.simplify = false;
+        } else if (strcmp(argv[i], "--no-decompose") == 0) {
+            options.decompose = false;
+        } else if (strcmp(argv[i], "--no-dedup") == 0) {
+            options.dedup = false;
+        } else if (strcmp(argv[i], "--perf-counters") == 0) {
+            options.perfCounters = true;
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            format = argv[++i];
+        } else if (strcmp(argv[i], "--count") == 0) {
+            options.count = true;
+        } else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            cacheDir = argv[++i];
+        } else if (strcmp(argv[i], "--cache-size") == 0 && i + 1 < argc) {
+            cacheSizeMb = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "--simd") == 0 && i + 1 < argc) {
+            options.simd = argv[++i];
+        } else if (strcmp(argv[i], "--bdd-order") == 0 && i + 1 < argc) {
+            options.bddOrder = argv[++i];
+        } else if (strcmp(argv[i], "--bdd-limit") == 0 && i + 1 < argc) {
+            options.bddNodeLimit = std::stoul(argv[++i]);
         } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
             printUsage();
             return 0;
@@ -249,89 +815,233 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    if (batchTimeoutSeconds < 0) {
+        std::cerr << "Erro: Timeout do lote não pode ser negativo" << std::endl;
+        return 1;
+    }
+    
+    if (options.engine != "bruteforce" && options.engine != "bitslice" && options.engine != "compiled" &&
+        options.engine != "gray" && options.engine != "sat" &&
+        options.engine != "bdd" && options.engine != "shannon") {
+        std::cerr << "Erro: Motor desconhecido: " << options.engine << std::endl;
+        return 1;
+    }
+    
+    if (options.threads < 0) {
+        std::cerr << "Erro: Número de threads não pode ser negativo" << std::endl;
+        return 1;
+    }
+    
+    if (options.jobs < 0) {
+        std::cerr << "Erro: Número de jobs não pode ser negativo" << std::endl;
+        return 1;
+    }
+    
+    if (!ReportWriter::parseFormat(format, options.format)) {
+        std::cerr << "Erro: Formato de saída desconhecido: " << format << std::endl;
+        return 1;
+    }
+    
     try {
-        PerformanceMonitor monitor;
-        
-        // Detect file type
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            throw std::runtime_error("Não foi possível abrir o arquivo: " + filename);
+        SimdDispatch::byName(options.simd);
+        BddEvaluator().setOrdering(options.bddOrder);
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    // A saída só é escrita quando o buffer enche e no fim da execução
+    OutputBuffer buffered(std::cout);
+    
+    // Em jsonl e csv a saída padrão tem só os registros; o resto vai para a de erro
+    ReportWriter writer(options.format, options.perfCounters);
+    std::ostream& log = writer.structured() ? std::cerr : std::cout;
+    
+    try {
+        std::unique_ptr<ResultCache> cache;
+        if (!cacheDir.empty()) {
+            cache.reset(new ResultCache(cacheDir, static_cast<uint64_t>(cacheSizeMb) * 1024 * 1024));
+            options.cache = cache.get();
         }
         
-        std::string firstLine;
-        std::getline(file, firstLine);
-        file.close();
+        // O arquivo é mapeado uma única vez: a detecção do tipo lê só a
+        // primeira linha e as instâncias são lidas sob demanda
+        InstanceReader reader(filename);
         
-        bool isInstancesFile = (firstLine.find("# Arquivo de Instâncias") != std::string::npos);
+        // Arquivo gerado pelo convert ou por generator --binary
+        std::unique_ptr<BinaryInstanceFile> binary;
+        if (BinaryInstances::isBinary(reader.mapping())) {
+            binary.reset(new BinaryInstanceFile(filename));
+        }
         
-        if (isInstancesFile) {
-            if (!instanceId.empty()) {
+        if (binary || reader.isInstancesFile()) {
+            if (!instanceId.empty() && binary) {
+                uint64_t index;
+                if (!binary->find(instanceId, index)) {
+                    throw std::runtime_error("Instância não encontrada: " + instanceId);
+                }
+                BinaryInstances::Entry entry = binary->entry(index);
+                AST ast;
+                binary->load(entry, ast);
+                InstanceReport report;
+                testFormulaWithTimeout(log, "", binary->id(entry).str(), binary->type(entry).str(),
+                                       verbose, debug, timeoutSeconds, options, false, nullptr,
+                                       writer.structured() ? &report : nullptr, &ast);
+                writer.header(std::cout);
+                writer.write(std::cout, report);
+                
+            } else if (!instanceId.empty()) {
                 // Test specific instance
                 auto instance = FileUtils::readInstanceById(filename, instanceId);
-                testFormulaWithTimeout(instance.formula, instance.id, instance.type, 
-                                     verbose, debug, monitor, timeoutSeconds);
+                InstanceReport report;
+                testFormulaWithTimeout(log, instance.formula, instance.id, instance.type,
+                                       verbose, debug, timeoutSeconds, options, false, nullptr,
+                                       writer.structured() ? &report : nullptr);
+                writer.header(std::cout);
+                writer.write(std::cout, report);
                 
             } else if (testAll) {
-                // Test all instances
-                auto instances = FileUtils::readInstances(filename);
+                // Test all instances, resolvidas à medida que são lidas
+                log << "Testando instâncias com timeout de " 
+                    << timeoutSeconds << " segundos cada..." << std::endl;
+                writer.header(std::cout);
                 
-                std::cout << "Testando " << instances.size() << " instâncias com timeout de " 
-                          << timeoutSeconds << " segundos cada..." << std::endl;
+                // Orçamento do lote inteiro; cada instância ainda tem o seu
+                Deadline batchDeadline(batchTimeoutSeconds * 1000LL, nullptr, "Batch");
                 
+                // Cada grupo de instâncias equivalentes é resolvido uma vez
+                EquivalenceGroups groups;
+                if (options.dedup) {
+                    options.groups = &groups;
+                }
+                
+                size_t totalCount = 0;
                 int successCount = 0;
                 int timeoutCount = 0;
                 int tautologyCount = 0;
                 
-                for (const auto& instance : instances) {
-                    try {
-                        testFormulaWithTimeout(instance.formula, instance.id, instance.type, 
-                                             verbose && !summaryOnly, debug, monitor, timeoutSeconds);
-                        successCount++;
-                        
-                        Parser parser(instance.formula);
-                        auto ast = parser.parse();
-                        std::vector<std::string> variables;
-                        ast->collectVariables(variables);
-                        
-                        if (variables.size() <= 15) { 
-                            TimeoutEvaluator evaluator(timeoutSeconds * 1000);
-                            if (evaluator.isTautologyWithTimeout(ast, variables)) {
-                                tautologyCount++;
-                            }
-                        }
-                        
-                    } catch (const std::runtime_error& e) {
-                        if (std::string(e.what()).find("TIMEOUT") != std::string::npos) {
-                            timeoutCount++;
-                            if (!summaryOnly) {
-                                std::cout << "Instância " << instance.id << " excedeu timeout" << std::endl;
-                            }
-                        } else {
-                            throw;
+                // Uma linha do arquivo texto ou uma entrada do diretório do
+                // binário; a AST do binário é carregada por quem resolve
+                struct BatchInstance {
+                    InstanceRecord text;
+                    uint64_t entry;
+                };
+                uint64_t nextEntry = 0;
+                auto next = [&](BatchInstance& instance) {
+                    if (!binary) return reader.next(instance.text);
+                    if (nextEntry >= binary->size()) return false;
+                    instance.entry = nextEntry++;
+                    return true;
+                };
+                auto idOf = [&](const BatchInstance& instance) {
+                    return binary ? binary->id(binary->entry(instance.entry)).str() : instance.text.id.str();
+                };
+                
+                // O veredito da própria execução alimenta o resumo
+                auto record = [&](const BatchInstance& instance, SolveStatus status) {
+                    if (status == SolveStatus::TIMED_OUT) {
+                        timeoutCount++;
+                        if (!summaryOnly && !writer.structured()) {
+                            std::cout << "Instância " << idOf(instance) << " excedeu timeout" << std::endl;
                         }
+                    } else {
+                        successCount++;
+                        if (status == SolveStatus::TAUTOLOGY) tautologyCount++;
                     }
+                };
+                
+                auto solve = [&](std::ostream& out, const BatchInstance& instance, bool concurrent,
+                                 InstanceReport& report) {
+                    InstanceReport* target = writer.structured() ? &report : nullptr;
+                    if (binary) {
+                        BinaryInstances::Entry entry = binary->entry(instance.entry);
+                        AST ast;
+                        binary->load(entry, ast);
+                        return testFormulaWithTimeout(out, "", binary->id(entry).str(), binary->type(entry).str(),
+                                                      verbose && !summaryOnly, debug, timeoutSeconds,
+                                                      options, concurrent, &batchDeadline, target, &ast);
+                    }
+                    const InstanceRecord& text = instance.text;
+                    return testFormulaWithTimeout(out, text.formula.str(), text.id.str(), text.type.str(),
+                                                  verbose && !summaryOnly, debug, timeoutSeconds,
+                                                  options, concurrent, &batchDeadline, target);
+                };
+                
+                if (ParallelSweep::resolveThreads(options.jobs) <= 1) {
+                    BatchInstance instance;
+                    while (next(instance)) {
+                        totalCount++;
+                        InstanceReport report;
+                        record(instance, solve(log, instance, false, report));
+                        writer.write(std::cout, report);
+                    }
+                } else {
+                    // Instâncias resolvidas em paralelo; a saída de cada uma
+                    // é impressa inteira e na ordem do arquivo. Só as que
+                    // estão na janela do lote ficam em memória.
+                    struct Job {
+                        BatchInstance instance;
+                        SolveStatus status;
+                        InstanceReport report;
+                    };
+                    OrderedBatch batch(options.jobs);
+                    std::vector<Job> jobs(batch.windowSize());
+                    auto job = [&](size_t i) -> Job& { return jobs[i % jobs.size()]; };
+                    
+                    totalCount = batch.run(
+                        [&](size_t i) {
+                            job(i).report = InstanceReport();
+                            return next(job(i).instance);
+                        },
+                        [&](size_t i, std::ostream& out) {
+                            job(i).status = solve(out, job(i).instance, true, job(i).report);
+                        },
+                        [&](size_t i, const std::string& output) {
+                            log << output;
+                            record(job(i).instance, job(i).status);
+                            writer.write(std::cout, job(i).report);
+                        });
                 }
                 
                 // Final summary
-                std::cout << "\n=== RESUMO FINAL ===" << std::endl;
-                std::cout << "Total de instâncias: " << instances.size() << std::endl;
-                std::cout << "Processadas com sucesso: " << successCount << std::endl;
-                std::cout << "Timeouts: " << timeoutCount << std::endl;
-                std::cout << "Tautologias encontradas: " << tautologyCount << std::endl;
-                std::cout << "==================" << std::endl;
+                log << "\n=== RESUMO FINAL ===" << std::endl;
+                log << "Total de instâncias: " << totalCount << std::endl;
+                log << "Processadas com sucesso: " << successCount << std::endl;
+                log << "Timeouts: " << timeoutCount << std::endl;
+                log << "Tautologias encontradas: " << tautologyCount << std::endl;
+                if (options.groups != nullptr) {
+                    log << "Equivalentes reaproveitadas: " << groups.reused << std::endl;
+                }
+                if (options.cache != nullptr) {
+                    log << "Cache: " << options.cache->hits << " acertos, "
+                        << options.cache->misses << " falhas" << std::endl;
+                }
+                log << "==================" << std::endl;
                 
             } else {
                 // List available instances
-                auto instances = FileUtils::readInstances(filename);
-                std::cout << "Arquivo contém " << instances.size() << " instâncias." << std::endl;
-                std::cout << "Timeout configurado: " << timeoutSeconds << " segundos" << std::endl;
-                std::cout << "Use -a para testar todas ou -i ID para testar uma específica." << std::endl;
+                size_t count = 0;
+                if (binary) {
+                    count = binary->size();
+                } else {
+                    InstanceRecord instance;
+                    while (reader.next(instance)) {
+                        count++;
+                    }
+                }
+                log << "Arquivo contém " << count << " instâncias." << std::endl;
+                log << "Timeout configurado: " << timeoutSeconds << " segundos" << std::endl;
+                log << "Use -a para testar todas ou -i ID para testar uma específica." << std::endl;
             }
             
         } else {
             // Single formula file
             std::string formula = FileUtils::readFormula(filename);
-            testFormulaWithTimeout(formula, filename, "", verbose, debug, monitor, timeoutSeconds);
+            InstanceReport report;
+            testFormulaWithTimeout(log, formula, filename, "", verbose, debug, timeoutSeconds, options, false, nullptr,
+                                   writer.structured() ? &report : nullptr);
+            writer.header(std::cout);
+            writer.write(std::cout, report);
         }
         
     } catch (const std::exception& e) {
@@ -0,0 +1,162 @@
+#include "parallel.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <thread>
+
+const int ParallelSweep::DEADLINE_POLL_MS;
+
+ParallelSweep::ParallelSweep(int threads, uint64_t chunk)
+    : numThreads(resolveThreads(threads)), chunkSize(std::max<uint64_t>(chunk, 1)),
+      stop(false), ranges(numThreads) {}
+
+int ParallelSweep::resolveThreads(int requested) {
+    if (requested > 0) {
+        return requested;
+    }
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? static_cast<int>(hw) : 1;
+}
+
+bool ParallelSweep::takeChunk(int worker, uint64_t& begin, uint64_t& end) {
+    WorkerRange& r = ranges[worker];
+    std::lock_guard<std::mutex> guard(r.lock);
+    if (r.next >= r.end) {
+        return false;
+    }
+    begin = r.next;
+    end = std::min(r.end, r.next + chunkSize);
+    r.next = end;
+    return true;
+}
+
+bool ParallelSweep::steal(int worker) {
+    // Vítima: a fatia com mais trabalho restante
+    int victim = -1;
+    uint64_t best = 0;
+    for (int i = 0; i < numThreads; ++i) {
+        if (i == worker) continue;
+        std::lock_guard<std::mutex> guard(ranges[i].lock);
+        uint64_t remaining = ranges[i].end - ranges[i].next;
+        if (remaining > best) {
+            best = remaining;
+            victim = i;
+        }
+    }
+    if (victim < 0) {
+        return false;
+    }
+
+    uint64_t begin, end;
+    {
+        std::lock_guard<std::mutex> guard(ranges[victim].lock);
+        uint64_t remaining = ranges[victim].end - ranges[victim].next;
+        if (remaining == 0) {
+            return true; // A vítima esvaziou no meio tempo; tenta de novo
+        }
+        // Rouba a metade final. Um resto de até um chunk vai inteiro: a vítima
+        // ainda não o pegou (takeChunk reserva antes de avaliar) e está ocupada
+        // com o chunk atual, então o ladrão o adianta
+        uint64_t taken = (remaining > chunkSize) ? remaining / 2 : remaining;
+        end = ranges[victim].end;
+        begin = end - taken;
+        ranges[victim].end = begin;
+    }
+
+    std::lock_guard<std::mutex> guard(ranges[worker].lock);
+    ranges[worker].next = begin;
+    ranges[worker].end = end;
+    return true;
+}
+
+bool ParallelSweep::run(uint64_t total, const ChunkFn& fn, const Deadline* deadline) {
+    stop.store(false);
+    metrics = Evaluator::Metrics();
+
+    // Fatias iniciais contíguas e do mesmo tamanho
+    uint64_t share = total / numThreads;
+    uint64_t extra = total % numThreads;
+    uint64_t offset = 0;
+    for (int i = 0; i < numThreads; ++i) {
+        uint64_t size = share + (static_cast<uint64_t>(i) < extra ? 1 : 0);
+        ranges[i].next = offset;
+        ranges[i].end = offset + size;
+        offset += size;
+    }
+
+    std::vector<Evaluator::Metrics> workerMetrics(numThreads);
+    std::atomic<bool> falsified(false);
+    std::exception_ptr error;
+    std::mutex doneLock;
+    std::condition_variable doneSignal;
+    int running = numThreads;
+
+    auto worker = [&](int id) {
+        try {
+            while (!shouldStop()) {
+                uint64_t begin, end;
+                if (!takeChunk(id, begin, end)) {
+                    if (!steal(id)) break;
+                    continue;
+                }
+                if (!fn(id, begin, end, workerMetrics[id])) {
+                    falsified.store(true);
+                    stop.store(true);
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(doneLock);
+            if (!error) error = std::current_exception();
+            stop.store(true);
+        }
+
+        std::lock_guard<std::mutex> guard(doneLock);
+        running--;
+        doneSignal.notify_all();
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; ++i) {
+        threads.push_back(std::thread(worker, i));
+    }
+
+    // As threads só consultam a flag de parada; quem lê o relógio é esta
+    // thread, acordando periodicamente enquanto houver um prazo
+    bool timedOut = false;
+    {
+        std::unique_lock<std::mutex> guard(doneLock);
+        if (deadline != nullptr) {
+            while (!doneSignal.wait_for(guard, std::chrono::milliseconds(DEADLINE_POLL_MS),
+                                        [&] { return running == 0; })) {
+                if (deadline->expired()) {
+                    timedOut = true;
+                    stop.store(true);
+                    break;
+                }
+            }
+        }
+        doneSignal.wait(guard, [&] { return running == 0; });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    for (const auto& m : workerMetrics) {
+        metrics.evaluations += m.evaluations;
+        metrics.stackOperations += m.stackOperations;
+        metrics.maxStackSize = std::max(metrics.maxStackSize, m.maxStackSize);
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (falsified.load()) {
+        return false;
+    }
+    if (timedOut) {
+        deadline->check();
+    }
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "evaluator.h"
+#include "deadline.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Varredura paralela de um intervalo [0, total) de unidades (linhas da tabela
+// verdade ou blocos bit-sliced). Cada thread começa com uma fatia contígua e
+// consome chunks do início dela; threads ociosas roubam metade do que resta
+// da fatia mais cheia. A primeira thread que encontra um contraexemplo sinaliza
+// parada e as demais abandonam o chunk atual.
+class ParallelSweep {
+public:
+    // Processa [begin, end) e devolve false ao encontrar uma atribuição que
+    // falsifica a fórmula. Deve consultar shouldStop() com frequência.
+    typedef std::function<bool(int worker, uint64_t begin, uint64_t end, Evaluator::Metrics& metrics)> ChunkFn;
+
+private:
+    struct WorkerRange {
+        std::mutex lock;
+        uint64_t next;
+        uint64_t end;
+    };
+
+    // Intervalo entre consultas ao prazo enquanto as threads trabalham
+    static const int DEADLINE_POLL_MS = 5;
+
+    int numThreads;
+    uint64_t chunkSize;
+    std::atomic<bool> stop;
+    std::vector<WorkerRange> ranges;
+
+    bool takeChunk(int worker, uint64_t& begin, uint64_t& end);
+    bool steal(int worker);
+
+public:
+    ParallelSweep(int threads, uint64_t chunk);
+
+    // Retorna true se nenhum chunk encontrou contraexemplo. Se deadline
+    // expirar antes do fim, sinaliza parada para as threads e lança "TIMEOUT".
+    bool run(uint64_t total, const ChunkFn& fn, const Deadline* deadline = nullptr);
+
+    bool shouldStop() const { return stop.load(std::memory_order_relaxed); }
+    const std::atomic<bool>* stopFlag() const { return &stop; }
+
+    // Soma das métricas por thread (maxStackSize é o máximo entre elas)
+    Evaluator::Metrics metrics;
+
+    // Número de threads efetivo: 0 significa todos os núcleos disponíveis
+    static int resolveThreads(int requested);
+};
+
+#endif
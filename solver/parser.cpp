@@ -1,8 +1,10 @@
 #include "parser.h"
 #include <stdexcept>
 #include <iostream>
+#include <utility>
 
-Parser::Parser(const std::string& formula) : formula(formula), pos(0) {}
+Parser::Parser(const std::string& formula, bool shareSubterms)
+    : formula(formula), pos(0), shareSubterms(shareSubterms) {}
 
 void Parser::skipWhitespace() {
     while (pos < formula.length() && std::isspace(formula[pos])) {
@@ -27,7 +29,11 @@ char Parser::consume() {
 }
 
 bool Parser::isVariable(char c) {
-    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+bool Parser::isVariablePart(char c) {
+    return isVariable(c) || (c >= '0' && c <= '9');
 }
 
 // Helper function to check for Unicode operators
@@ -46,79 +52,71 @@ void Parser::consumeOperator(const std::string& op) {
     }
 }
 
-std::shared_ptr<ASTNode> Parser::parse() {
+AST Parser::parse() {
     pos = 0;
-    auto result = parseExpression();
+    ast = AST();
+    ast.setHashConsing(shareSubterms);
+    ast.reserve(formula.length() / 3);
+    ast.setRoot(parseExpression());
     skipWhitespace();
     if (pos < formula.length()) {
         throw std::runtime_error("Caracteres extras no final da fórmula");
     }
-    return result;
+    return std::move(ast);
 }
 
 // Precedência: → (menor) < ∨ < ∧ < ¬ (maior)
-std::shared_ptr<ASTNode> Parser::parseExpression() {
+NodeId Parser::parseExpression() {
     return parseImplication();
 }
 
-std::shared_ptr<ASTNode> Parser::parseImplication() {
+NodeId Parser::parseImplication() {
     auto left = parseOr();
     
     while (checkOperator("→")) {
         consumeOperator("→");
         auto right = parseOr();
-        auto node = std::make_shared<ASTNode>(NodeType::IMPLIES);
-        node->left = left;
-        node->right = right;
-        left = node;
+        left = ast.addNode(NodeType::IMPLIES, left, right);
     }
     
     return left;
 }
 
-std::shared_ptr<ASTNode> Parser::parseOr() {
+NodeId Parser::parseOr() {
     auto left = parseAnd();
     
     while (checkOperator("∨")) {
         consumeOperator("∨");
         auto right = parseAnd();
-        auto node = std::make_shared<ASTNode>(NodeType::OR);
-        node->left = left;
-        node->right = right;
-        left = node;
+        left = ast.addNode(NodeType::OR, left, right);
     }
     
     return left;
 }
 
-std::shared_ptr<ASTNode> Parser::parseAnd() {
+NodeId Parser::parseAnd() {
     auto left = parseNot();
     
     while (checkOperator("∧")) {
         consumeOperator("∧");
         auto right = parseNot();
-        auto node = std::make_shared<ASTNode>(NodeType::AND);
-        node->left = left;
-        node->right = right;
-        left = node;
+        left = ast.addNode(NodeType::AND, left, right);
     }
     
     return left;
 }
 
-std::shared_ptr<ASTNode> Parser::parseNot() {
+NodeId Parser::parseNot() {
     if (checkOperator("¬")) {
         consumeOperator("¬");
         auto operand = parseNot(); // Para permitir ¬¬p
-        auto node = std::make_shared<ASTNode>(NodeType::NOT);
-        node->left = operand;
-        return node;
+        return ast.addNode(NodeType::NOT, operand);
     }
     
     return parsePrimary();
 }
 
-std::shared_ptr<ASTNode> Parser::parsePrimary() {
+NodeId Parser::parsePrimary() {
     char c = peek();
     
     if (c == '(') {
@@ -132,8 +130,12 @@ std::shared_ptr<ASTNode> Parser::parsePrimary() {
     }
     
     if (isVariable(c)) {
-        std::string varName(1, consume());
-        return std::make_shared<ASTNode>(NodeType::VARIABLE, varName);
+        // Identificador: letra ou _ seguido de letras, dígitos ou _ (x17, req_ok)
+        size_t start = pos;
+        while (pos < formula.length() && isVariablePart(formula[pos])) {
+            pos++;
+        }
+        return ast.addVariable(formula.substr(start, pos - start));
     }
     
     throw std::runtime_error("Token inesperado: " + std::string(1, c));
@@ -3,32 +3,34 @@
 
 #include "../common/ast.h"
 #include <string>
-#include <memory>
-#include <stack>
 
 class Parser {
 private:
     std::string formula;
     size_t pos;
+    bool shareSubterms;
+    AST ast;
     
     void skipWhitespace();
     char peek();
     char consume();
     bool isVariable(char c);
+    bool isVariablePart(char c);
     
     bool checkOperator(const std::string& op);
     void consumeOperator(const std::string& op);
     
-    std::shared_ptr<ASTNode> parseExpression();
-    std::shared_ptr<ASTNode> parseImplication();
-    std::shared_ptr<ASTNode> parseOr();
-    std::shared_ptr<ASTNode> parseAnd();
-    std::shared_ptr<ASTNode> parseNot();
-    std::shared_ptr<ASTNode> parsePrimary();
+    NodeId parseExpression();
+    NodeId parseImplication();
+    NodeId parseOr();
+    NodeId parseAnd();
+    NodeId parseNot();
+    NodeId parsePrimary();
     
 public:
-    Parser(const std::string& formula);
-    std::shared_ptr<ASTNode> parse();
+    // Com shareSubterms, subfórmulas idênticas viram um único nó (DAG)
+    Parser(const std::string& formula, bool shareSubterms = false);
+    AST parse();
 };
 
 #endif
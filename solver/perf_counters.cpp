@@ -0,0 +1,210 @@
+#include "perf_counters.h"
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#ifdef __linux__
+#define PERF_EVENTS 1
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+static thread_local PhaseProfile* currentProfile = nullptr;
+
+PerfCounters::PerfCounters() {
+    for (int e = 0; e < NUM_EVENTS; ++e) {
+        fds[e] = -1;
+    }
+
+#ifdef PERF_EVENTS
+    static const uint64_t CONFIGS[NUM_EVENTS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+    for (int e = 0; e < NUM_EVENTS; ++e) {
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = CONFIGS[e];
+        attr.inherit = 1;
+        // Só espaço de usuário: basta perf_event_paranoid <= 2
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        fds[e] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fds[e] < 0 && error.empty()) {
+            error = std::string("perf_event_open: ") + std::strerror(errno);
+        }
+    }
+#else
+    error = "perf_event_open não existe nesta plataforma";
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef PERF_EVENTS
+    for (int e = 0; e < NUM_EVENTS; ++e) {
+        if (fds[e] >= 0) close(fds[e]);
+    }
+#endif
+}
+
+bool PerfCounters::anyAvailable() const {
+    for (int e = 0; e < NUM_EVENTS; ++e) {
+        if (fds[e] >= 0) return true;
+    }
+    return false;
+}
+
+void PerfCounters::read(uint64_t values[NUM_EVENTS]) const {
+    for (int e = 0; e < NUM_EVENTS; ++e) {
+        values[e] = 0;
+#ifdef PERF_EVENTS
+        if (fds[e] < 0) continue;
+        // valor, tempo habilitado, tempo contando
+        uint64_t data[3] = { 0, 0, 0 };
+        if (::read(fds[e], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+        if (data[2] > 0 && data[2] < data[1]) {
+            // Contador multiplexado: extrapola para o tempo todo
+            values[e] = static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+        } else {
+            values[e] = data[0];
+        }
+#endif
+    }
+}
+
+PhaseProfile::Sample::Sample() : ran(false), wallMicros(0), peakRssKb(0) {
+    for (int e = 0; e < PerfCounters::NUM_EVENTS; ++e) {
+        counters[e] = 0;
+    }
+}
+
+PhaseProfile::PhaseProfile() {
+    mark();
+}
+
+void PhaseProfile::mark() {
+    markTime = std::chrono::steady_clock::now();
+    counters.read(markCounters);
+}
+
+void PhaseProfile::charge(SolverPhase phase) {
+    uint64_t now[PerfCounters::NUM_EVENTS];
+    counters.read(now);
+    auto time = std::chrono::steady_clock::now();
+
+    Sample& s = samples[static_cast<int>(phase)];
+    s.ran = true;
+    s.wallMicros += std::chrono::duration_cast<std::chrono::microseconds>(time - markTime).count();
+    for (int e = 0; e < PerfCounters::NUM_EVENTS; ++e) {
+        s.counters[e] += now[e] - markCounters[e];
+    }
+    s.peakRssKb = peakRssKb();
+}
+
+void PhaseProfile::begin(SolverPhase phase) {
+    // A fase de fora para de acumular enquanto a de dentro roda
+    if (!open.empty()) charge(open.back());
+    open.push_back(phase);
+    mark();
+}
+
+void PhaseProfile::end() {
+    if (open.empty()) return;
+    charge(open.back());
+    open.pop_back();
+    mark();
+}
+
+const char* PhaseProfile::phaseName(SolverPhase phase) {
+    switch (phase) {
+        case SolverPhase::PARSE: return "parse";
+        case SolverPhase::VARIABLES: return "variables";
+        case SolverPhase::SIMPLIFY: return "simplify";
+        case SolverPhase::COMPILE: return "compile";
+        case SolverPhase::SWEEP: return "sweep";
+        default: return "?";
+    }
+}
+
+const char* PhaseProfile::phaseLabel(SolverPhase phase) {
+    switch (phase) {
+        case SolverPhase::PARSE: return "parse";
+        case SolverPhase::VARIABLES: return "variáveis";
+        case SolverPhase::SIMPLIFY: return "simplificação";
+        case SolverPhase::COMPILE: return "compilação";
+        case SolverPhase::SWEEP: return "varredura";
+        default: return "?";
+    }
+}
+
+const char* PhaseProfile::eventName(PerfCounters::Event e) {
+    switch (e) {
+        case PerfCounters::CYCLES: return "cycles";
+        case PerfCounters::INSTRUCTIONS: return "instructions";
+        case PerfCounters::CACHE_MISSES: return "cache_misses";
+        case PerfCounters::BRANCH_MISSES: return "branch_misses";
+        default: return "?";
+    }
+}
+
+void PhaseProfile::print(std::ostream& out) const {
+    if (!counters.anyAvailable()) {
+        out << "Contadores de hardware indisponíveis (" << counters.error << "); só tempo e memória" << std::endl;
+    }
+
+    for (int p = 0; p < static_cast<int>(SolverPhase::COUNT); ++p) {
+        const Sample& s = samples[p];
+        if (!s.ran) continue;
+
+        out << "Fase " << phaseLabel(static_cast<SolverPhase>(p)) << ": " << s.wallMicros << " μs";
+        for (int e = 0; e < PerfCounters::NUM_EVENTS; ++e) {
+            if (!counters.available(static_cast<PerfCounters::Event>(e))) continue;
+            out << ", " << eventName(static_cast<PerfCounters::Event>(e)) << "=" << s.counters[e];
+        }
+        if (counters.available(PerfCounters::CYCLES) && counters.available(PerfCounters::INSTRUCTIONS) &&
+            s.counters[PerfCounters::CYCLES] > 0) {
+            std::ostringstream ipc;
+            ipc << std::fixed << std::setprecision(2)
+                << static_cast<double>(s.counters[PerfCounters::INSTRUCTIONS]) / s.counters[PerfCounters::CYCLES];
+            out << ", IPC=" << ipc.str();
+        }
+        if (s.peakRssKb > 0) {
+            out << ", RSS máximo=" << s.peakRssKb << " KB";
+        }
+        out << std::endl;
+    }
+}
+
+long PhaseProfile::peakRssKb() {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        return static_cast<long>(usage.ru_maxrss / 1024);  // bytes no macOS
+#else
+        return static_cast<long>(usage.ru_maxrss);
+#endif
+    }
+#endif
+    return 0;
+}
+
+PhaseProfile* PhaseProfile::current() {
+    return currentProfile;
+}
+
+void PhaseProfile::setCurrent(PhaseProfile* profile) {
+    currentProfile = profile;
+}
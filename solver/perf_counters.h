@@ -0,0 +1,131 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Fases de uma instância medidas por --perf-counters
+enum class SolverPhase {
+    PARSE,      // Texto → AST (ou cópia da AST do arquivo binário)
+    VARIABLES,  // Ordenação e coleta das variáveis
+    SIMPLIFY,   // Simplificação e decomposição em termos
+    COMPILE,    // Programa do motor: bit-sliced/JIT, bytecode, Tseitin
+    SWEEP,      // Execução do motor
+    COUNT
+};
+
+// Contadores de hardware da thread que os cria via perf_event_open (Linux).
+// Threads criadas depois (varredura paralela, termos) herdam os contadores e
+// entram na soma quando terminam. Cada contador é aberto separadamente: um
+// que a CPU ou o kernel não oferece fica indisponível sem afetar os outros.
+class PerfCounters {
+public:
+    enum Event { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, NUM_EVENTS };
+
+private:
+    int fds[NUM_EVENTS];
+
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available(Event e) const { return fds[e] >= 0; }
+    bool anyAvailable() const;
+
+    // Valores acumulados desde a abertura, corrigidos pela multiplexação
+    void read(uint64_t values[NUM_EVENTS]) const;
+
+    // Motivo de o primeiro contador não abrir (vazio se todos abriram)
+    std::string error;
+};
+
+// Medidas de uma instância por fase: tempo de parede, contadores e o pico de
+// memória residente do processo ao fim da fase. O tempo de uma fase aninhada
+// (a compilação dentro do motor) não entra na fase de fora.
+class PhaseProfile {
+public:
+    struct Sample {
+        bool ran;
+        long long wallMicros;
+        uint64_t counters[PerfCounters::NUM_EVENTS];
+        long peakRssKb;     // 0 se a plataforma não informa
+
+        Sample();
+    };
+
+private:
+    PerfCounters counters;
+    Sample samples[static_cast<int>(SolverPhase::COUNT)];
+
+    // Fases abertas, a mais interna no topo, e o início da medida atual
+    std::vector<SolverPhase> open;
+    std::chrono::steady_clock::time_point markTime;
+    uint64_t markCounters[PerfCounters::NUM_EVENTS];
+
+    void mark();
+    void charge(SolverPhase phase);
+
+public:
+    PhaseProfile();
+
+    void begin(SolverPhase phase);
+    void end();
+
+    const Sample& sample(SolverPhase phase) const { return samples[static_cast<int>(phase)]; }
+    bool counterAvailable(PerfCounters::Event e) const { return counters.available(e); }
+    const std::string& counterError() const { return counters.error; }
+
+    // Linhas "Fase ..." do bloco de resultado
+    void print(std::ostream& out) const;
+
+    // Nome da fase para saída estruturada e rótulo do bloco de resultado
+    static const char* phaseName(SolverPhase phase);
+    static const char* phaseLabel(SolverPhase phase);
+    static const char* eventName(PerfCounters::Event e);
+
+    // Pico de memória residente do processo, em KB (0 se indisponível)
+    static long peakRssKb();
+
+    // Perfil da instância sendo resolvida nesta thread (nullptr sem --perf-counters)
+    static PhaseProfile* current();
+    static void setCurrent(PhaseProfile* profile);
+};
+
+// Marca uma fase no perfil da thread atual; sem perfil não faz nada
+class PhaseScope {
+private:
+    PhaseProfile* profile;
+
+public:
+    explicit PhaseScope(SolverPhase phase) : profile(PhaseProfile::current()) {
+        if (profile != nullptr) profile->begin(phase);
+    }
+    ~PhaseScope() {
+        if (profile != nullptr) profile->end();
+    }
+
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+};
+
+// Torna um perfil o atual da thread enquanto existir (nullptr não faz nada)
+class ActiveProfile {
+public:
+    explicit ActiveProfile(PhaseProfile* profile) {
+        if (profile != nullptr) PhaseProfile::setCurrent(profile);
+    }
+    ~ActiveProfile() {
+        PhaseProfile::setCurrent(nullptr);
+    }
+
+    ActiveProfile(const ActiveProfile&) = delete;
+    ActiveProfile& operator=(const ActiveProfile&) = delete;
+};
+
+#endif
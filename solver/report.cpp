@@ -0,0 +1,303 @@
+#include "report.h"
+#include <cstdio>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+InstanceReport::InstanceReport()
+    : checked(false), consistent(false), status(SolveStatus::NOT_TAUTOLOGY), variables(0), nodes(0),
+      source("solved"), timeMicros(0), profiled(false) {
+    for (int e = 0; e < PerfCounters::NUM_EVENTS; ++e) {
+        counterAvailable[e] = false;
+    }
+}
+
+void InstanceReport::setProfile(const PhaseProfile& profile) {
+    profiled = true;
+    for (int p = 0; p < static_cast<int>(SolverPhase::COUNT); ++p) {
+        phases[p] = profile.sample(static_cast<SolverPhase>(p));
+    }
+    for (int e = 0; e < PerfCounters::NUM_EVENTS; ++e) {
+        counterAvailable[e] = profile.counterAvailable(static_cast<PerfCounters::Event>(e));
+    }
+}
+
+namespace {
+
+void appendJsonString(std::string& line, const std::string& text) {
+    line += '"';
+    for (unsigned char c : text) {
+        switch (c) {
+            case '"': line += "\\\""; break;
+            case '\\': line += "\\\\"; break;
+            case '\n': line += "\\n"; break;
+            case '\r': line += "\\r"; break;
+            case '\t': line += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    line += escaped;
+                } else {
+                    line += static_cast<char>(c);
+                }
+        }
+    }
+    line += '"';
+}
+
+// Campo CSV entre aspas só quando precisa (RFC 4180)
+void appendCsvField(std::string& line, const std::string& text) {
+    if (text.find_first_of(",\"\r\n") == std::string::npos) {
+        line += text;
+        return;
+    }
+    line += '"';
+    for (char c : text) {
+        if (c == '"') line += '"';
+        line += c;
+    }
+    line += '"';
+}
+
+template <typename T>
+void appendNumber(std::string& line, T value) {
+    line += std::to_string(value);
+}
+
+// A contagem vem como "N de 2^n (p%)"; o registro leva só N
+std::string modelCount(const std::string& models) {
+    return models.substr(0, models.find(' '));
+}
+
+const char* const COLUMNS[] = {
+    "id", "verdict", "expected", "consistent", "variables", "nodes", "engine", "source", "representative",
+    "time_us", "jit_compile_us", "evaluations", "stack_operations", "max_stack_size", "models", "counterexample"
+};
+
+} // namespace
+
+bool ReportWriter::parseFormat(const std::string& name, OutputFormat& format) {
+    if (name == "text") {
+        format = OutputFormat::TEXT;
+    } else if (name == "jsonl") {
+        format = OutputFormat::JSONL;
+    } else if (name == "csv") {
+        format = OutputFormat::CSV;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* ReportWriter::statusName(SolveStatus status) {
+    switch (status) {
+        case SolveStatus::TAUTOLOGY: return "tautology";
+        case SolveStatus::NOT_TAUTOLOGY: return "not_tautology";
+        case SolveStatus::TIMED_OUT: return "timeout";
+        default: return "?";
+    }
+}
+
+void ReportWriter::header(std::ostream& out) const {
+    if (format != OutputFormat::CSV) return;
+
+    std::string line;
+    for (size_t c = 0; c < sizeof(COLUMNS) / sizeof(COLUMNS[0]); ++c) {
+        if (c > 0) line += ',';
+        line += COLUMNS[c];
+    }
+    if (phases) {
+        for (int p = 0; p < static_cast<int>(SolverPhase::COUNT); ++p) {
+            const std::string phase = PhaseProfile::phaseName(static_cast<SolverPhase>(p));
+            line += "," + phase + "_wall_us";
+            for (int e = 0; e < PerfCounters::NUM_EVENTS; ++e) {
+                line += "," + phase + "_" + PhaseProfile::eventName(static_cast<PerfCounters::Event>(e));
+            }
+            line += "," + phase + "_peak_rss_kb";
+        }
+    }
+    line += '\n';
+    out.write(line.data(), line.size());
+}
+
+void ReportWriter::write(std::ostream& out, const InstanceReport& report) const {
+    std::string line;
+    line.reserve(256);
+
+    if (format == OutputFormat::JSONL) {
+        line += "{\"id\":";
+        appendJsonString(line, report.id);
+        line += ",\"verdict\":\"";
+        line += statusName(report.status);
+        line += '"';
+        if (!report.expected.empty()) {
+            line += ",\"expected\":";
+            appendJsonString(line, report.expected);
+        }
+        if (report.checked) {
+            line += report.consistent ? ",\"consistent\":true" : ",\"consistent\":false";
+        }
+        line += ",\"variables\":";
+        appendNumber(line, report.variables);
+        line += ",\"nodes\":";
+        appendNumber(line, report.nodes);
+        if (!report.engine.empty()) {
+            line += ",\"engine\":";
+            appendJsonString(line, report.engine);
+        }
+        line += ",\"source\":";
+        appendJsonString(line, report.source);
+        if (!report.representative.empty()) {
+            line += ",\"representative\":";
+            appendJsonString(line, report.representative);
+        }
+        line += ",\"time_us\":";
+        appendNumber(line, report.timeMicros);
+        line += ",\"jit_compile_us\":";
+        appendNumber(line, report.metrics.compileTime);
+        line += ",\"evaluations\":";
+        appendNumber(line, report.metrics.evaluations);
+        line += ",\"stack_operations\":";
+        appendNumber(line, report.metrics.stackOperations);
+        line += ",\"max_stack_size\":";
+        appendNumber(line, report.metrics.maxStackSize);
+        if (!report.models.empty()) {
+            line += ",\"models\":";
+            appendJsonString(line, modelCount(report.models));
+        }
+        if (!report.counterexample.empty()) {
+            line += ",\"counterexample\":";
+            appendJsonString(line, report.counterexample);
+        }
+        if (report.profiled) {
+            line += ",\"phases\":{";
+            bool first = true;
+            for (int p = 0; p < static_cast<int>(SolverPhase::COUNT); ++p) {
+                const PhaseProfile::Sample& s = report.phases[p];
+                if (!s.ran) continue;
+                if (!first) line += ',';
+                first = false;
+                line += '"';
+                line += PhaseProfile::phaseName(static_cast<SolverPhase>(p));
+                line += "\":{\"wall_us\":";
+                appendNumber(line, s.wallMicros);
+                for (int e = 0; e < PerfCounters::NUM_EVENTS; ++e) {
+                    if (!report.counterAvailable[e]) continue;
+                    line += ",\"";
+                    line += PhaseProfile::eventName(static_cast<PerfCounters::Event>(e));
+                    line += "\":";
+                    appendNumber(line, s.counters[e]);
+                }
+                if (s.peakRssKb > 0) {
+                    line += ",\"peak_rss_kb\":";
+                    appendNumber(line, s.peakRssKb);
+                }
+                line += '}';
+            }
+            line += '}';
+        }
+        line += "}\n";
+
+    } else if (format == OutputFormat::CSV) {
+        appendCsvField(line, report.id);
+        line += ',';
+        line += statusName(report.status);
+        line += ',';
+        appendCsvField(line, report.expected);
+        line += ',';
+        if (report.checked) line += report.consistent ? "true" : "false";
+        line += ',';
+        appendNumber(line, report.variables);
+        line += ',';
+        appendNumber(line, report.nodes);
+        line += ',';
+        appendCsvField(line, report.engine);
+        line += ',';
+        appendCsvField(line, report.source);
+        line += ',';
+        appendCsvField(line, report.representative);
+        line += ',';
+        appendNumber(line, report.timeMicros);
+        line += ',';
+        appendNumber(line, report.metrics.compileTime);
+        line += ',';
+        appendNumber(line, report.metrics.evaluations);
+        line += ',';
+        appendNumber(line, report.metrics.stackOperations);
+        line += ',';
+        appendNumber(line, report.metrics.maxStackSize);
+        line += ',';
+        appendCsvField(line, modelCount(report.models));
+        line += ',';
+        appendCsvField(line, report.counterexample);
+        if (phases) {
+            // Fases que não rodaram e contadores indisponíveis ficam vazios
+            for (int p = 0; p < static_cast<int>(SolverPhase::COUNT); ++p) {
+                const PhaseProfile::Sample& s = report.phases[p];
+                const bool ran = report.profiled && s.ran;
+                line += ',';
+                if (ran) appendNumber(line, s.wallMicros);
+                for (int e = 0; e < PerfCounters::NUM_EVENTS; ++e) {
+                    line += ',';
+                    if (ran && report.counterAvailable[e]) appendNumber(line, s.counters[e]);
+                }
+                line += ',';
+                if (ran && s.peakRssKb > 0) appendNumber(line, s.peakRssKb);
+            }
+        }
+        line += '\n';
+
+    } else {
+        return;
+    }
+
+    out.write(line.data(), line.size());
+}
+
+OutputBuffer::OutputBuffer(std::ostream& output, size_t capacity) : stream(output), target(nullptr) {
+    if (interactive()) return;
+
+    buffer.resize(capacity);
+    setp(buffer.data(), buffer.data() + buffer.size());
+    target = stream.rdbuf(this);
+}
+
+OutputBuffer::~OutputBuffer() {
+    if (target == nullptr) return;
+
+    drain();
+    target->pubsync();
+    stream.rdbuf(target);
+}
+
+bool OutputBuffer::drain() {
+    const std::streamsize pending = pptr() - pbase();
+    if (pending > 0 && target->sputn(pbase(), pending) != pending) return false;
+    setp(buffer.data(), buffer.data() + buffer.size());
+    return true;
+}
+
+OutputBuffer::int_type OutputBuffer::overflow(int_type c) {
+    if (!drain()) return traits_type::eof();
+    if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+}
+
+int OutputBuffer::sync() {
+    // flush e std::endl só marcam o fim de uma linha; a escrita espera o buffer encher
+    return 0;
+}
+
+bool OutputBuffer::interactive() {
+#ifdef _WIN32
+    return _isatty(_fileno(stdout)) != 0;
+#else
+    return isatty(fileno(stdout)) != 0;
+#endif
+}
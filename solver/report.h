@@ -0,0 +1,103 @@
+#ifndef REPORT_H
+#define REPORT_H
+
+#include "evaluator.h"
+#include "perf_counters.h"
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Formato da saída de cada instância (--format)
+enum class OutputFormat {
+    TEXT,   // Bloco de resultado em português (padrão)
+    JSONL,  // Um objeto JSON por linha
+    CSV     // Uma linha por instância, com cabeçalho
+};
+
+// Veredito de uma instância, usado na contagem do resumo do modo -a
+enum class SolveStatus { TAUTOLOGY, NOT_TAUTOLOGY, TIMED_OUT };
+
+// Tudo o que a saída estruturada registra de uma instância
+struct InstanceReport {
+    std::string id;
+    std::string expected;           // Tipo esperado do arquivo de instâncias (vazio se não há)
+    bool checked;                   // O veredito foi comparado com o tipo esperado
+    bool consistent;
+    SolveStatus status;
+    size_t variables;
+    size_t nodes;                   // Nós da AST lida, antes da simplificação
+    std::string engine;             // Motor que decidiu (inclui os fallbacks para sat)
+    std::string source;             // solved, cache ou equivalent
+    std::string representative;     // Instância que resolveu, com source = equivalent
+    long long timeMicros;
+    Evaluator::Metrics metrics;
+    std::string models;             // Contagem de --count, como no bloco de texto
+    std::string counterexample;     // "a=1, b=0", se o motor produz um
+
+    // Medidas de --perf-counters
+    bool profiled;
+    PhaseProfile::Sample phases[static_cast<int>(SolverPhase::COUNT)];
+    bool counterAvailable[PerfCounters::NUM_EVENTS];
+
+    InstanceReport();
+
+    // Copia as medidas por fase de um perfil já encerrado
+    void setProfile(const PhaseProfile& profile);
+};
+
+// Escreve os registros de InstanceReport em JSON Lines ou CSV. No formato
+// texto não escreve nada: o bloco de resultado já foi impresso.
+class ReportWriter {
+private:
+    OutputFormat format;
+    bool phases;    // Colunas por fase no CSV (--perf-counters)
+
+public:
+    ReportWriter(OutputFormat outputFormat, bool withPhases) : format(outputFormat), phases(withPhases) {}
+
+    // false se o nome não é text, jsonl nem csv
+    static bool parseFormat(const std::string& name, OutputFormat& format);
+
+    bool structured() const { return format != OutputFormat::TEXT; }
+
+    // Linha de cabeçalho do CSV (as colunas são fixas para a execução)
+    void header(std::ostream& out) const;
+
+    void write(std::ostream& out, const InstanceReport& report) const;
+
+    static const char* statusName(SolveStatus status);
+};
+
+// Buffer grande na frente do stream da saída padrão (std::cout) enquanto
+// existir. Só é descarregado quando enche e na destruição: std::endl e flush
+// não forçam mais uma escrita por linha. Se a saída padrão é um terminal não
+// faz nada, para que os resultados apareçam à medida que saem.
+class OutputBuffer : public std::streambuf {
+public:
+    static const size_t DEFAULT_CAPACITY = 1 << 20;
+
+private:
+    std::ostream& stream;
+    std::streambuf* target;     // Buffer original do stream; nullptr se inativo
+    std::vector<char> buffer;
+
+    bool drain();
+
+protected:
+    int_type overflow(int_type c) override;
+    int sync() override;
+
+public:
+    explicit OutputBuffer(std::ostream& output, size_t capacity = DEFAULT_CAPACITY);
+    ~OutputBuffer();
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    // A saída padrão é um terminal
+    static bool interactive();
+};
+
+#endif
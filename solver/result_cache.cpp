@@ -0,0 +1,226 @@
+#include "result_cache.h"
+#include "../common/sha256.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <utime.h>
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+static const char* const ENTRY_MAGIC = "TCCACHE 1";
+static const char* const ENTRY_SUFFIX = ".tc";
+static const char* const TEMP_PREFIX = ".tmp-";
+
+// Temporários mais velhos que isso foram abandonados por um processo que morreu
+static const time_t STALE_TEMP_SECONDS = 3600;
+
+static bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static int processId() {
+#ifdef _WIN32
+    return _getpid();
+#else
+    return static_cast<int>(getpid());
+#endif
+}
+
+ResultCache::ResultCache(const std::string& dir, uint64_t maxBytes)
+    : directory(dir), capacity(maxBytes), bytes(0), sequence(0), hits(0), misses(0) {
+#ifdef _WIN32
+    _mkdir(dir.c_str());
+#else
+    mkdir(dir.c_str(), 0755);
+#endif
+    struct stat info;
+    if (stat(dir.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+        throw std::runtime_error("Não foi possível usar o diretório de cache: " + dir);
+    }
+    evict();
+}
+
+std::string ResultCache::entryPath(const std::string& key) const {
+    return directory + "/" + key + ENTRY_SUFFIX;
+}
+
+std::string ResultCache::fingerprint(const AST& formula) {
+    Sha256 hash;
+    hash.update("tautology-checker/formula/1");
+    if (formula.empty()) return hash.hexDigest();
+
+    // Pós-ordem a partir da raiz (esquerda antes da direita) sobre uma AST
+    // com hash-consing: o resultado não depende da ordem nem do
+    // compartilhamento do arena original
+    AST canonical;
+    canonical.setHashConsing(true);
+    std::vector<NodeId> remap(formula.size(), INVALID_NODE);
+    std::vector<std::pair<NodeId, bool> > pending(1, std::make_pair(formula.getRoot(), false));
+    while (!pending.empty()) {
+        NodeId id = pending.back().first;
+        bool expanded = pending.back().second;
+        pending.pop_back();
+        if (remap[id] != INVALID_NODE) continue;
+
+        const ASTNode& node = formula.node(id);
+        if (node.isLeaf()) {
+            remap[id] = canonical.addVariable(formula.variableName(node.varId()));
+        } else if (!expanded) {
+            pending.push_back(std::make_pair(id, true));
+            if (node.isBinary()) pending.push_back(std::make_pair(node.right, false));
+            pending.push_back(std::make_pair(node.left, false));
+        } else if (node.isUnary()) {
+            remap[id] = canonical.addNode(node.type, remap[node.left]);
+        } else {
+            remap[id] = canonical.addNode(node.type, remap[node.left], remap[node.right]);
+        }
+    }
+
+    for (NodeId id = 0; id < canonical.size(); ++id) {
+        const ASTNode& node = canonical.node(id);
+        const uint8_t type = static_cast<uint8_t>(node.type);
+        hash.update(&type, 1);
+        if (node.isLeaf()) {
+            const std::string& name = canonical.variableName(node.varId());
+            const uint32_t length = static_cast<uint32_t>(name.size());
+            hash.update(&length, sizeof(length));
+            hash.update(name);
+        } else {
+            hash.update(&node.left, sizeof(node.left));
+            if (node.isBinary()) hash.update(&node.right, sizeof(node.right));
+        }
+    }
+    return hash.hexDigest();
+}
+
+bool ResultCache::lookup(const std::string& key, Entry& entry, bool needModels, bool needCounterexample) {
+    const std::string path = entryPath(key);
+    std::ifstream file(path);
+    std::string magic, storedKey, verdict;
+    Entry found;
+    bool valid = file.is_open() && std::getline(file, magic) && magic == ENTRY_MAGIC &&
+                 std::getline(file, storedKey) && storedKey == "key " + key &&
+                 std::getline(file, verdict) && (verdict == "verdict 1" || verdict == "verdict 0") &&
+                 std::getline(file, found.engine) && std::getline(file, found.models) &&
+                 std::getline(file, found.counterexample) &&
+                 found.engine.compare(0, 7, "engine ") == 0 && found.models.compare(0, 7, "models ") == 0 &&
+                 found.counterexample.compare(0, 15, "counterexample ") == 0;
+    if (!valid) {
+        misses++;
+        return false;
+    }
+
+    found.isTautology = (verdict == "verdict 1");
+    found.engine.erase(0, 7);
+    found.models.erase(0, 7);
+    found.counterexample.erase(0, 15);
+    entry = found;
+    if ((needModels && found.models.empty()) ||
+        (needCounterexample && !found.isTautology && found.counterexample.empty())) {
+        misses++;
+        return false;
+    }
+    hits++;
+
+    // O acesso renova a entrada para o LRU
+    utime(path.c_str(), nullptr);
+    return true;
+}
+
+void ResultCache::store(const std::string& key, const Entry& entry) {
+    std::ostringstream content;
+    content << ENTRY_MAGIC << "\n"
+            << "key " << key << "\n"
+            << "verdict " << (entry.isTautology ? 1 : 0) << "\n"
+            << "engine " << entry.engine << "\n"
+            << "models " << entry.models << "\n"
+            << "counterexample " << entry.counterexample << "\n";
+    const std::string text = content.str();
+
+    std::ostringstream temp;
+    temp << directory << "/" << TEMP_PREFIX << processId() << "-" << sequence++;
+    {
+        std::ofstream file(temp.str(), std::ios::binary | std::ios::trunc);
+        file << text;
+        if (!file) {
+            // Cache é só uma otimização: falhas de gravação são ignoradas
+            file.close();
+            std::remove(temp.str().c_str());
+            return;
+        }
+    }
+
+    const std::string path = entryPath(key);
+#ifdef _WIN32
+    // No Windows rename não substitui um arquivo existente
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temp.str().c_str(), path.c_str()) != 0) {
+        std::remove(temp.str().c_str());
+        return;
+    }
+
+    if ((bytes += text.size()) > capacity) {
+        evict();
+    }
+}
+
+void ResultCache::evict() {
+    // Uma thread por vez; as outras seguem sem esperar
+    std::unique_lock<std::mutex> guard(evicting, std::try_to_lock);
+    if (!guard.owns_lock()) return;
+
+    struct File {
+        time_t accessed;
+        uint64_t size;
+        std::string path;
+    };
+    std::vector<File> files;
+    uint64_t total = 0;
+    const time_t now = std::time(nullptr);
+
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr) return;
+    while (struct dirent* item = readdir(dir)) {
+        const std::string name = item->d_name;
+        const std::string path = directory + "/" + name;
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) continue;
+
+        if (name.compare(0, 5, TEMP_PREFIX) == 0) {
+            if (now - info.st_mtime > STALE_TEMP_SECONDS) std::remove(path.c_str());
+            continue;
+        }
+        if (!endsWith(name, ENTRY_SUFFIX)) continue;
+
+        File file = { info.st_mtime, static_cast<uint64_t>(info.st_size), path };
+        files.push_back(file);
+        total += file.size;
+    }
+    closedir(dir);
+
+    if (total > capacity) {
+        std::sort(files.begin(), files.end(), [](const File& a, const File& b) {
+            return a.accessed < b.accessed;
+        });
+        const uint64_t target = capacity / 10 * 9;
+        for (size_t i = 0; i < files.size() && total > target; ++i) {
+            // Outro processo pode ter removido o arquivo antes
+            std::remove(files[i].path.c_str());
+            total -= files[i].size;
+        }
+    }
+    bytes = total;
+}
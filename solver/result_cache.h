@@ -0,0 +1,64 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "../common/ast.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// Cache persistente de resultados (--cache DIR). A chave de uma fórmula é o
+// SHA-256 da sua forma canônica: o DAG alcançável a partir da raiz, com
+// subfórmulas iguais unificadas e numerado em pós-ordem, e as folhas
+// identificadas pelo nome da variável. Fórmulas que só diferem no
+// compartilhamento (--no-share, formato binário) têm a mesma chave.
+//
+// Cada resultado é um arquivo de texto <chave>.tc no diretório. A gravação
+// vai para um arquivo temporário único e é publicada com rename, de modo que
+// vários processos podem escrever ao mesmo tempo e um leitor nunca vê um
+// arquivo pela metade. A data de modificação marca o último acesso: quando
+// o diretório passa do limite, os menos usados recentemente são removidos.
+class ResultCache {
+public:
+    struct Entry {
+        bool isTautology;
+        std::string engine;
+        std::string models;          // Contagem de --count; vazio se não houve
+        std::string counterexample;  // "a=1, b=0"; vazio se não há
+
+        Entry() : isTautology(false) {}
+    };
+
+private:
+    std::string directory;
+    uint64_t capacity;
+    std::atomic<uint64_t> bytes;        // Estimativa do tamanho do diretório
+    std::atomic<uint64_t> sequence;     // Nomes únicos dos temporários
+    std::mutex evicting;
+
+    std::string entryPath(const std::string& key) const;
+
+    // Recalcula o tamanho do diretório e remove as entradas mais antigas
+    // até ficar abaixo de 90% do limite
+    void evict();
+
+public:
+    static const uint64_t DEFAULT_CAPACITY = 64ULL * 1024 * 1024;
+
+    // Cria o diretório se ele não existir
+    ResultCache(const std::string& dir, uint64_t maxBytes = DEFAULT_CAPACITY);
+
+    static std::string fingerprint(const AST& formula);
+
+    // Seguros para chamadas concorrentes. lookup só conta como acerto uma
+    // entrada que tem a contagem (needModels) e, se a fórmula não é
+    // tautologia, o contraexemplo (needCounterexample); uma entrada
+    // incompleta ainda é devolvida em entry, para ser completada.
+    bool lookup(const std::string& key, Entry& entry, bool needModels, bool needCounterexample);
+    void store(const std::string& key, const Entry& entry);
+
+    std::atomic<long long> hits;
+    std::atomic<long long> misses;
+};
+
+#endif
@@ -0,0 +1,472 @@
+#include "sat.h"
+#include <algorithm>
+#include <cmath>
+
+const SatSolver::ClauseRef SatSolver::NO_REASON;
+static const Lit UNDEF_LIT = 0xFFFFFFFFu;
+
+SatSolver::SatSolver()
+    : qhead(0), ok(true), varInc(1.0), clauseInc(1.0), maxLearnts(0), deadline(nullptr) {}
+
+uint32_t SatSolver::newVar() {
+    uint32_t v = numVars();
+    assigns.push_back(-1);
+    level.push_back(0);
+    reason.push_back(NO_REASON);
+    polarity.push_back(1);
+    activity.push_back(0.0);
+    heapIndex.push_back(-1);
+    seen.push_back(0);
+    watches.resize(2 * (v + 1));
+    heapInsert(v);
+    return v;
+}
+
+bool SatSolver::addClause(std::vector<Lit> lits) {
+    if (!ok) return false;
+
+    // Ordena para achar duplicatas e pares x, ¬x (literais adjacentes)
+    std::sort(lits.begin(), lits.end());
+    size_t j = 0;
+    for (size_t i = 0; i < lits.size(); ++i) {
+        Lit l = lits[i];
+        if (value(l) == 1 || (i > 0 && l == negLit(lits[i - 1]))) {
+            return true; // Cláusula já satisfeita ou tautológica
+        }
+        if (value(l) != 0 && (j == 0 || lits[j - 1] != l)) {
+            lits[j++] = l;
+        }
+    }
+    lits.resize(j);
+
+    if (lits.empty()) {
+        ok = false;
+        return false;
+    }
+    if (lits.size() == 1) {
+        enqueue(lits[0], NO_REASON);
+        ok = (propagate() == NO_REASON);
+        return ok;
+    }
+
+    Clause c;
+    c.lits = lits;
+    c.learnt = false;
+    c.deleted = false;
+    c.lbd = 0;
+    c.activity = 0.0;
+    clauses.push_back(c);
+    attach(static_cast<ClauseRef>(clauses.size() - 1));
+    return true;
+}
+
+void SatSolver::attach(ClauseRef cref) {
+    const Clause& c = clauses[cref];
+    Watcher w0 = { cref, c.lits[1] };
+    Watcher w1 = { cref, c.lits[0] };
+    watches[negLit(c.lits[0])].push_back(w0);
+    watches[negLit(c.lits[1])].push_back(w1);
+}
+
+void SatSolver::enqueue(Lit l, ClauseRef from) {
+    uint32_t v = litVar(l);
+    assigns[v] = litSign(l) ? 0 : 1;
+    level[v] = decisionLevel();
+    reason[v] = from;
+    trail.push_back(l);
+}
+
+SatSolver::ClauseRef SatSolver::propagate() {
+    ClauseRef conflict = NO_REASON;
+
+    while (qhead < trail.size()) {
+        Lit p = trail[qhead++];
+        Lit falseLit = negLit(p);
+        std::vector<Watcher>& ws = watches[p];
+        stats.propagations++;
+
+        size_t i = 0, j = 0;
+        while (i < ws.size()) {
+            Watcher w = ws[i];
+            if (value(w.blocker) == 1) {
+                ws[j++] = ws[i++];
+                continue;
+            }
+
+            Clause& c = clauses[w.cref];
+            if (c.deleted) {
+                i++;
+                continue;
+            }
+
+            // O literal falso fica na posição 1
+            if (c.lits[0] == falseLit) {
+                std::swap(c.lits[0], c.lits[1]);
+            }
+            i++;
+
+            Lit first = c.lits[0];
+            Watcher kept = { w.cref, first };
+            if (first != w.blocker && value(first) == 1) {
+                ws[j++] = kept;
+                continue;
+            }
+
+            // Procura outro literal não falso para observar
+            bool moved = false;
+            for (size_t k = 2; k < c.lits.size(); ++k) {
+                if (value(c.lits[k]) != 0) {
+                    std::swap(c.lits[1], c.lits[k]);
+                    watches[negLit(c.lits[1])].push_back(kept);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) continue;
+
+            // Cláusula unitária ou em conflito
+            ws[j++] = kept;
+            if (value(first) == 0) {
+                conflict = w.cref;
+                qhead = trail.size();
+                while (i < ws.size()) {
+                    ws[j++] = ws[i++];
+                }
+            } else {
+                enqueue(first, w.cref);
+            }
+        }
+        ws.resize(j);
+    }
+
+    return conflict;
+}
+
+bool SatSolver::isRedundant(Lit l) const {
+    // Minimização local: o literal sai se todos os antecedentes da sua
+    // razão já estão na cláusula aprendida ou no nível 0
+    const Clause& c = clauses[reason[litVar(l)]];
+    for (size_t k = 1; k < c.lits.size(); ++k) {
+        uint32_t v = litVar(c.lits[k]);
+        if (!seen[v] && level[v] > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SatSolver::analyze(ClauseRef conflict, std::vector<Lit>& learnt, uint32_t& backtrackLevel, uint32_t& lbd) {
+    int pathCount = 0;
+    Lit p = UNDEF_LIT;
+    size_t index = trail.size();
+
+    learnt.clear();
+    learnt.push_back(UNDEF_LIT); // Reservado para o UIP
+
+    ClauseRef cref = conflict;
+    do {
+        Clause& c = clauses[cref];
+        if (c.learnt) {
+            bumpClause(c);
+        }
+
+        for (size_t k = (p == UNDEF_LIT) ? 0 : 1; k < c.lits.size(); ++k) {
+            Lit q = c.lits[k];
+            uint32_t v = litVar(q);
+            if (!seen[v] && level[v] > 0) {
+                bumpVar(v);
+                seen[v] = 1;
+                if (level[v] >= decisionLevel()) {
+                    pathCount++;
+                } else {
+                    learnt.push_back(q);
+                }
+            }
+        }
+
+        // Próximo literal marcado, do fim da trilha para o início
+        while (!seen[litVar(trail[--index])]) {}
+        p = trail[index];
+        cref = reason[litVar(p)];
+        seen[litVar(p)] = 0;
+        pathCount--;
+    } while (pathCount > 0);
+
+    learnt[0] = negLit(p);
+
+    std::vector<Lit> marked(learnt.begin() + 1, learnt.end());
+    size_t j = 1;
+    for (size_t i = 1; i < learnt.size(); ++i) {
+        if (reason[litVar(learnt[i])] == NO_REASON || !isRedundant(learnt[i])) {
+            learnt[j++] = learnt[i];
+        }
+    }
+    learnt.resize(j);
+    for (Lit l : marked) {
+        seen[litVar(l)] = 0;
+    }
+
+    // O literal de maior nível (depois do UIP) fica na posição 1
+    backtrackLevel = 0;
+    if (learnt.size() > 1) {
+        size_t maxIndex = 1;
+        for (size_t i = 2; i < learnt.size(); ++i) {
+            if (level[litVar(learnt[i])] > level[litVar(learnt[maxIndex])]) {
+                maxIndex = i;
+            }
+        }
+        std::swap(learnt[1], learnt[maxIndex]);
+        backtrackLevel = level[litVar(learnt[1])];
+    }
+
+    // LBD: número de níveis de decisão distintos na cláusula
+    std::vector<uint32_t> levels;
+    for (Lit l : learnt) {
+        levels.push_back(level[litVar(l)]);
+    }
+    std::sort(levels.begin(), levels.end());
+    lbd = static_cast<uint32_t>(std::unique(levels.begin(), levels.end()) - levels.begin());
+}
+
+void SatSolver::backtrack(uint32_t targetLevel) {
+    if (decisionLevel() <= targetLevel) return;
+
+    for (size_t c = trail.size(); c > trailLim[targetLevel]; --c) {
+        Lit l = trail[c - 1];
+        uint32_t v = litVar(l);
+        assigns[v] = -1;
+        reason[v] = NO_REASON;
+        polarity[v] = litSign(l) ? 1 : 0;
+        if (heapIndex[v] < 0) {
+            heapInsert(v);
+        }
+    }
+    trail.resize(trailLim[targetLevel]);
+    trailLim.resize(targetLevel);
+    qhead = trail.size();
+}
+
+Lit SatSolver::pickBranchLit() {
+    while (!heap.empty()) {
+        uint32_t v = heapPop();
+        if (assigns[v] < 0) {
+            return makeLit(v, polarity[v] != 0);
+        }
+    }
+    return UNDEF_LIT;
+}
+
+bool SatSolver::locked(ClauseRef cref) const {
+    const Clause& c = clauses[cref];
+    uint32_t v = litVar(c.lits[0]);
+    return reason[v] == cref && value(c.lits[0]) == 1;
+}
+
+void SatSolver::reduceLearnts() {
+    // Piores primeiro: LBD alto e, no empate, atividade baixa
+    std::sort(learnts.begin(), learnts.end(), [this](ClauseRef a, ClauseRef b) {
+        const Clause& ca = clauses[a];
+        const Clause& cb = clauses[b];
+        if (ca.lbd != cb.lbd) return ca.lbd > cb.lbd;
+        return ca.activity < cb.activity;
+    });
+
+    size_t half = learnts.size() / 2;
+    size_t j = 0;
+    for (size_t i = 0; i < learnts.size(); ++i) {
+        Clause& c = clauses[learnts[i]];
+        if (i < half && c.lbd > 2 && !locked(learnts[i])) {
+            c.deleted = true;
+            std::vector<Lit>().swap(c.lits);
+            stats.deletedClauses++;
+        } else {
+            learnts[j++] = learnts[i];
+        }
+    }
+    learnts.resize(j);
+
+    // Reconstrói as listas de observação sem as cláusulas removidas;
+    // os literais observados continuam nas posições 0 e 1
+    for (auto& ws : watches) {
+        ws.clear();
+    }
+    for (ClauseRef cref = 0; cref < clauses.size(); ++cref) {
+        if (!clauses[cref].deleted) {
+            attach(cref);
+        }
+    }
+}
+
+void SatSolver::bumpVar(uint32_t v) {
+    activity[v] += varInc;
+    if (activity[v] > 1e100) {
+        for (auto& a : activity) {
+            a *= 1e-100;
+        }
+        varInc *= 1e-100;
+    }
+    if (heapIndex[v] >= 0) {
+        heapUp(heapIndex[v]);
+    }
+}
+
+void SatSolver::bumpClause(Clause& c) {
+    c.activity += clauseInc;
+    if (c.activity > 1e20) {
+        for (ClauseRef cref : learnts) {
+            clauses[cref].activity *= 1e-20;
+        }
+        clauseInc *= 1e-20;
+    }
+}
+
+void SatSolver::heapInsert(uint32_t v) {
+    heapIndex[v] = static_cast<int>(heap.size());
+    heap.push_back(v);
+    heapUp(heapIndex[v]);
+}
+
+void SatSolver::heapUp(int i) {
+    uint32_t v = heap[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (activity[heap[parent]] >= activity[v]) break;
+        heap[i] = heap[parent];
+        heapIndex[heap[i]] = i;
+        i = parent;
+    }
+    heap[i] = v;
+    heapIndex[v] = i;
+}
+
+void SatSolver::heapDown(int i) {
+    uint32_t v = heap[i];
+    int size = static_cast<int>(heap.size());
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= size) break;
+        if (child + 1 < size && activity[heap[child + 1]] > activity[heap[child]]) {
+            child++;
+        }
+        if (activity[heap[child]] <= activity[v]) break;
+        heap[i] = heap[child];
+        heapIndex[heap[i]] = i;
+        i = child;
+    }
+    heap[i] = v;
+    heapIndex[v] = i;
+}
+
+uint32_t SatSolver::heapPop() {
+    uint32_t top = heap[0];
+    heapIndex[top] = -1;
+    uint32_t last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        heap[0] = last;
+        heapIndex[last] = 0;
+        heapDown(0);
+    }
+    return top;
+}
+
+double SatSolver::luby(double y, int x) {
+    // Encontra a subsequência que contém x e o expoente correspondente
+    int size = 1;
+    int seq = 0;
+    while (size < x + 1) {
+        seq++;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != x) {
+        size = (size - 1) >> 1;
+        seq--;
+        x = x % size;
+    }
+    return std::pow(y, seq);
+}
+
+SatSolver::Result SatSolver::solve() {
+    if (!ok) return UNSATISFIABLE;
+
+    if (propagate() != NO_REASON) {
+        ok = false;
+        return UNSATISFIABLE;
+    }
+
+    maxLearnts = std::max(clauses.size() / 3.0, 2000.0);
+    std::vector<Lit> learnt;
+    int restart = 0;
+
+    for (;;) {
+        const long long budget = static_cast<long long>(luby(2.0, restart) * 100);
+        long long conflictsHere = 0;
+
+        for (;;) {
+            ClauseRef conflict = propagate();
+            stats.maxTrailSize = std::max(stats.maxTrailSize, trail.size());
+
+            if (conflict != NO_REASON) {
+                stats.conflicts++;
+                conflictsHere++;
+                if (decisionLevel() == 0) {
+                    ok = false;
+                    return UNSATISFIABLE;
+                }
+
+                uint32_t backtrackLevel, lbd;
+                analyze(conflict, learnt, backtrackLevel, lbd);
+                backtrack(backtrackLevel);
+
+                if (learnt.size() == 1) {
+                    enqueue(learnt[0], NO_REASON);
+                } else {
+                    Clause c;
+                    c.lits = learnt;
+                    c.learnt = true;
+                    c.deleted = false;
+                    c.lbd = lbd;
+                    c.activity = 0.0;
+                    clauses.push_back(c);
+                    ClauseRef cref = static_cast<ClauseRef>(clauses.size() - 1);
+                    attach(cref);
+                    learnts.push_back(cref);
+                    bumpClause(clauses[cref]);
+                    enqueue(learnt[0], cref);
+                }
+                stats.learnedClauses++;
+
+                varInc /= 0.95;
+                clauseInc /= 0.999;
+
+                if (stats.conflicts % 1024 == 0 && timedOut()) {
+                    return UNKNOWN;
+                }
+            } else {
+                if (conflictsHere >= budget) {
+                    backtrack(0);
+                    stats.restarts++;
+                    restart++;
+                    break;
+                }
+
+                if (learnts.size() >= maxLearnts) {
+                    reduceLearnts();
+                    maxLearnts *= 1.1;
+                }
+
+                Lit next = pickBranchLit();
+                if (next == UNDEF_LIT) {
+                    return SATISFIABLE;
+                }
+
+                stats.decisions++;
+                if (stats.decisions % 1024 == 0 && timedOut()) {
+                    return UNKNOWN;
+                }
+                trailLim.push_back(trail.size());
+                enqueue(next, NO_REASON);
+            }
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#ifndef SAT_H
+#define SAT_H
+
+#include "deadline.h"
+#include <cstdint>
+#include <vector>
+
+// Literal: 2 * variável + sinal (sinal 1 = negado)
+typedef uint32_t Lit;
+
+inline Lit makeLit(uint32_t var, bool negated = false) { return (var << 1) | (negated ? 1 : 0); }
+inline Lit negLit(Lit l) { return l ^ 1; }
+inline uint32_t litVar(Lit l) { return l >> 1; }
+inline bool litSign(Lit l) { return (l & 1) != 0; }
+
+// Solver SAT CDCL: propagação com dois literais observados, heurística VSIDS
+// com salvamento de fase, aprendizado de cláusulas pelo primeiro UIP,
+// reinícios na sequência de Luby e remoção periódica de cláusulas aprendidas
+// com LBD alto.
+class SatSolver {
+public:
+    enum Result { SATISFIABLE, UNSATISFIABLE, UNKNOWN };
+
+    struct Stats {
+        long long decisions;
+        long long propagations;
+        long long conflicts;
+        long long restarts;
+        long long learnedClauses;
+        long long deletedClauses;
+        size_t maxTrailSize;
+
+        Stats() : decisions(0), propagations(0), conflicts(0), restarts(0),
+                  learnedClauses(0), deletedClauses(0), maxTrailSize(0) {}
+    };
+
+private:
+    typedef uint32_t ClauseRef;
+    static const ClauseRef NO_REASON = 0xFFFFFFFFu;
+
+    struct Clause {
+        std::vector<Lit> lits;
+        bool learnt;
+        bool deleted;
+        uint32_t lbd;
+        double activity;
+    };
+
+    struct Watcher {
+        ClauseRef cref;
+        Lit blocker;
+    };
+
+    std::vector<Clause> clauses;
+    std::vector<ClauseRef> learnts;
+    std::vector<std::vector<Watcher>> watches;   // Indexado por literal
+
+    std::vector<int8_t> assigns;                 // -1 indefinida, 0 falsa, 1 verdadeira
+    std::vector<uint32_t> level;
+    std::vector<ClauseRef> reason;
+    std::vector<uint8_t> polarity;               // Fase salva (1 = negada)
+    std::vector<Lit> trail;
+    std::vector<size_t> trailLim;
+    size_t qhead;
+    bool ok;
+
+    // VSIDS: atividades e heap binário de variáveis
+    std::vector<double> activity;
+    std::vector<int> heapIndex;
+    std::vector<uint32_t> heap;
+    double varInc;
+    double clauseInc;
+
+    std::vector<uint8_t> seen;
+    double maxLearnts;
+    const Deadline* deadline;
+
+    bool timedOut() const { return deadline != nullptr && deadline->expired(); }
+
+    int8_t value(Lit l) const {
+        int8_t v = assigns[litVar(l)];
+        return v < 0 ? v : static_cast<int8_t>(v ^ (l & 1));
+    }
+    uint32_t decisionLevel() const { return static_cast<uint32_t>(trailLim.size()); }
+
+    void attach(ClauseRef cref);
+    void enqueue(Lit l, ClauseRef from);
+    ClauseRef propagate();
+    void analyze(ClauseRef conflict, std::vector<Lit>& learnt, uint32_t& backtrackLevel, uint32_t& lbd);
+    bool isRedundant(Lit l) const;
+    void backtrack(uint32_t targetLevel);
+    Lit pickBranchLit();
+    void reduceLearnts();
+    bool locked(ClauseRef cref) const;
+
+    void bumpVar(uint32_t v);
+    void bumpClause(Clause& c);
+    void heapInsert(uint32_t v);
+    void heapUp(int i);
+    void heapDown(int i);
+    uint32_t heapPop();
+
+    static double luby(double y, int x);
+
+public:
+    SatSolver();
+
+    uint32_t newVar();
+    uint32_t numVars() const { return static_cast<uint32_t>(assigns.size()); }
+
+    // Retorna false se a fórmula já é trivialmente insatisfatível
+    bool addClause(std::vector<Lit> lits);
+
+    // A busca devolve UNKNOWN se o prazo expirar (consultado a cada 1024
+    // conflitos ou decisões)
+    void setDeadline(const Deadline* limit) { deadline = limit; }
+
+    Result solve();
+
+    // Valor da variável no modelo após SATISFIABLE
+    bool modelValue(uint32_t var) const { return assigns[var] == 1; }
+
+    Stats stats;
+};
+
+#endif
@@ -0,0 +1,173 @@
+#include "shannon.h"
+#include <algorithm>
+
+const NodeId ShannonEvaluator::TRUE_NODE;
+const NodeId ShannonEvaluator::FALSE_NODE;
+
+static bool isConstant(NodeId id) {
+    return id == ShannonEvaluator::TRUE_NODE || id == ShannonEvaluator::FALSE_NODE;
+}
+
+NodeId ShannonEvaluator::fold(Level& out, NodeType type, NodeId left, NodeId right) const {
+    // x e ¬x como filhos do mesmo conectivo
+    auto complementary = [&](NodeId a, NodeId b) {
+        return (!isConstant(a) && out.nodes[a].type == NodeType::NOT && out.nodes[a].left == b) ||
+               (!isConstant(b) && out.nodes[b].type == NodeType::NOT && out.nodes[b].left == a);
+    };
+
+    switch (type) {
+        case NodeType::NOT:
+            if (left == TRUE_NODE) return FALSE_NODE;
+            if (left == FALSE_NODE) return TRUE_NODE;
+            if (out.nodes[left].type == NodeType::NOT) return out.nodes[left].left;
+            break;
+        case NodeType::AND:
+            if (left == FALSE_NODE || right == FALSE_NODE) return FALSE_NODE;
+            if (left == TRUE_NODE) return right;
+            if (right == TRUE_NODE) return left;
+            if (left == right) return left;
+            if (complementary(left, right)) return FALSE_NODE;
+            break;
+        case NodeType::OR:
+            if (left == TRUE_NODE || right == TRUE_NODE) return TRUE_NODE;
+            if (left == FALSE_NODE) return right;
+            if (right == FALSE_NODE) return left;
+            if (left == right) return left;
+            if (complementary(left, right)) return TRUE_NODE;
+            break;
+        case NodeType::IMPLIES:
+            if (left == FALSE_NODE || right == TRUE_NODE) return TRUE_NODE;
+            if (left == TRUE_NODE) return right;
+            if (right == FALSE_NODE) return fold(out, NodeType::NOT, left, INVALID_NODE);
+            if (left == right) return TRUE_NODE;
+            break;
+        case NodeType::VARIABLE:
+            break;
+    }
+
+    ASTNode node;
+    node.type = type;
+    node.left = left;
+    node.right = right;
+    out.nodes.push_back(node);
+    return static_cast<NodeId>(out.nodes.size() - 1);
+}
+
+void ShannonEvaluator::restrict(const ASTNode* nodes, size_t size, NodeId root, int64_t var, bool value, Level& out) {
+    out.nodes.clear();
+
+    // Só o que ainda é alcançável a partir da raiz é copiado
+    reachable.assign(size, false);
+    reachable[root] = true;
+    for (NodeId id = static_cast<NodeId>(size); id-- > 0;) {
+        if (!reachable[id]) continue;
+        if (!nodes[id].isLeaf()) reachable[nodes[id].left] = true;
+        if (nodes[id].isBinary()) reachable[nodes[id].right] = true;
+    }
+
+    remap.resize(size);
+    for (NodeId id = 0; id < size; ++id) {
+        if (!reachable[id]) continue;
+        const ASTNode& node = nodes[id];
+        metrics.stackOperations++;
+
+        if (node.type == NodeType::VARIABLE) {
+            if (static_cast<int64_t>(node.varId()) == var) {
+                remap[id] = value ? TRUE_NODE : FALSE_NODE;
+            } else {
+                out.nodes.push_back(node);
+                remap[id] = static_cast<NodeId>(out.nodes.size() - 1);
+            }
+        } else if (node.type == NodeType::NOT) {
+            remap[id] = fold(out, NodeType::NOT, remap[node.left], INVALID_NODE);
+        } else {
+            remap[id] = fold(out, node.type, remap[node.left], remap[node.right]);
+        }
+    }
+
+    out.root = remap[root];
+}
+
+uint32_t ShannonEvaluator::chooseVariable(const Level& level) {
+    const size_t size = level.nodes.size();
+    reachable.assign(size, false);
+    reachable[level.root] = true;
+    std::fill(occurrences.begin(), occurrences.end(), 0);
+
+    for (NodeId id = static_cast<NodeId>(size); id-- > 0;) {
+        if (!reachable[id]) continue;
+        const ASTNode& node = level.nodes[id];
+        if (node.isLeaf()) {
+            occurrences[node.varId()]++;
+            continue;
+        }
+        reachable[node.left] = true;
+        if (node.isBinary()) reachable[node.right] = true;
+    }
+
+    return static_cast<uint32_t>(std::max_element(occurrences.begin(), occurrences.end()) - occurrences.begin());
+}
+
+bool ShannonEvaluator::isTautology(const AST& formula) {
+    resetMetrics();
+    if (formula.empty()) return false;
+
+    const size_t numVars = formula.numVariables();
+    occurrences.assign(numVars, 0);
+
+    // levels[d] é a fórmula restrita pelas d primeiras decisões de frames
+    std::vector<Level> levels(1);
+    std::vector<Frame> frames;
+    restrict(formula.data(), formula.size(), formula.getRoot(), -1, false, levels[0]);
+
+    for (;;) {
+        metrics.evaluations++;
+        if (deadline != nullptr && (metrics.evaluations & 1023) == 0) {
+            deadline->check();
+        }
+
+        const NodeId root = levels[frames.size()].root;
+
+        if (root == FALSE_NODE) {
+            // Variáveis não decididas não importam; ficam falsas
+            model.assign(numVars, false);
+            for (const auto& frame : frames) {
+                model[frame.var] = frame.value;
+            }
+            return false;
+        }
+
+        if (root == TRUE_NODE) {
+            // Volta até a última decisão que ainda não tentou verdadeiro
+            while (!frames.empty() && frames.back().value) {
+                frames.pop_back();
+            }
+            if (frames.empty()) {
+                return true;
+            }
+            frames.back().value = true;
+            const size_t depth = frames.size();
+            const Level& parent = levels[depth - 1];
+            restrict(parent.nodes.data(), parent.nodes.size(), parent.root, frames.back().var, true, levels[depth]);
+            continue;
+        }
+
+        Frame frame;
+        frame.var = chooseVariable(levels[frames.size()]);
+        frame.value = false;
+        frames.push_back(frame);
+        metrics.maxStackSize = std::max(metrics.maxStackSize, frames.size());
+
+        const size_t depth = frames.size();
+        if (levels.size() <= depth) {
+            levels.emplace_back();
+        }
+        const Level& parent = levels[depth - 1];
+        restrict(parent.nodes.data(), parent.nodes.size(), parent.root, frame.var, false, levels[depth]);
+    }
+}
+
+void ShannonEvaluator::resetMetrics() {
+    metrics = Evaluator::Metrics();
+    model.clear();
+}
@@ -0,0 +1,61 @@
+#ifndef SHANNON_H
+#define SHANNON_H
+
+#include "../common/ast.h"
+#include "evaluator.h"
+#include "deadline.h"
+#include <cstdint>
+#include <vector>
+
+// Expansão de Shannon com simplificação: escolhe uma variável, substitui
+// falso e verdadeiro na fórmula, propaga as constantes (⊤ ∧ x → x,
+// ⊥ → x → ⊤, ...) e continua só com o que sobrou. Um ramo que vira ⊥ é um
+// contraexemplo imediato; um ramo que vira ⊤ é descartado sem enumerar as
+// variáveis restantes. A busca em profundidade usa uma pilha explícita.
+class ShannonEvaluator {
+private:
+    // Fórmula restrita de um nível da busca: mesmos nós da AST, com as
+    // constantes representadas por IDs reservados
+    struct Level {
+        std::vector<ASTNode> nodes;
+        NodeId root;
+    };
+
+    struct Frame {
+        uint32_t var;
+        bool value;
+    };
+
+    const Deadline* deadline;
+    std::vector<bool> model;
+
+    // Buffers reaproveitados entre chamadas de restrict
+    std::vector<NodeId> remap;
+    std::vector<bool> reachable;
+    std::vector<uint32_t> occurrences;
+
+    NodeId fold(Level& out, NodeType type, NodeId left, NodeId right) const;
+
+    // Copia os nós alcançáveis de in para out, trocando var por value e
+    // simplificando as constantes (var < 0 apenas simplifica)
+    void restrict(const ASTNode* nodes, size_t size, NodeId root, int64_t var, bool value, Level& out);
+
+    // Variável mais frequente na fórmula restante
+    uint32_t chooseVariable(const Level& level);
+
+public:
+    static const NodeId TRUE_NODE = 0xFFFFFFFEu;
+    static const NodeId FALSE_NODE = 0xFFFFFFFDu;
+
+    ShannonEvaluator(const Deadline* limit = nullptr) : deadline(limit) {}
+
+    bool isTautology(const AST& formula);
+    const std::vector<bool>& counterexample() const { return model; }
+
+    // evaluations conta ramos visitados, stackOperations nós reconstruídos
+    // e maxStackSize a maior profundidade da busca
+    Evaluator::Metrics metrics;
+    void resetMetrics();
+};
+
+#endif
@@ -0,0 +1,155 @@
+#include "simd.h"
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+static void runScalar(const BitSliceInstruction* program, size_t size,
+                      const uint64_t* varWords, uint64_t* s) {
+    for (size_t i = 0; i < size; ++i) {
+        const BitSliceInstruction& inst = program[i];
+        switch (inst.type) {
+            case NodeType::VARIABLE:
+                s[i] = varWords[inst.left];
+                break;
+            case NodeType::NOT:
+                s[i] = ~s[inst.left];
+                break;
+            case NodeType::AND:
+                s[i] = s[inst.left] & s[inst.right];
+                break;
+            case NodeType::OR:
+                s[i] = s[inst.left] | s[inst.right];
+                break;
+            case NodeType::IMPLIES:
+                s[i] = ~s[inst.left] | s[inst.right]; // p → q ≡ ¬p ∨ q
+                break;
+        }
+    }
+}
+
+#ifdef SIMD_X86
+
+__attribute__((target("avx2")))
+static void runAvx2(const BitSliceInstruction* program, size_t size,
+                    const uint64_t* varWords, uint64_t* slots) {
+    __m256i* s = reinterpret_cast<__m256i*>(slots);
+    const __m256i* v = reinterpret_cast<const __m256i*>(varWords);
+    const __m256i ones = _mm256_set1_epi64x(-1);
+
+    for (size_t i = 0; i < size; ++i) {
+        const BitSliceInstruction& inst = program[i];
+        __m256i r;
+        switch (inst.type) {
+            case NodeType::VARIABLE:
+                r = _mm256_loadu_si256(v + inst.left);
+                break;
+            case NodeType::NOT:
+                r = _mm256_xor_si256(_mm256_loadu_si256(s + inst.left), ones);
+                break;
+            case NodeType::AND:
+                r = _mm256_and_si256(_mm256_loadu_si256(s + inst.left), _mm256_loadu_si256(s + inst.right));
+                break;
+            case NodeType::OR:
+                r = _mm256_or_si256(_mm256_loadu_si256(s + inst.left), _mm256_loadu_si256(s + inst.right));
+                break;
+            case NodeType::IMPLIES:
+                // ¬p ∨ q ≡ ¬(p ∧ ¬q)
+                r = _mm256_xor_si256(_mm256_andnot_si256(_mm256_loadu_si256(s + inst.right),
+                                                         _mm256_loadu_si256(s + inst.left)), ones);
+                break;
+            default:
+                r = _mm256_setzero_si256();
+                break;
+        }
+        _mm256_storeu_si256(s + i, r);
+    }
+}
+
+__attribute__((target("avx512f")))
+static void runAvx512(const BitSliceInstruction* program, size_t size,
+                      const uint64_t* varWords, uint64_t* slots) {
+    __m512i* s = reinterpret_cast<__m512i*>(slots);
+    const __m512i* v = reinterpret_cast<const __m512i*>(varWords);
+
+    for (size_t i = 0; i < size; ++i) {
+        const BitSliceInstruction& inst = program[i];
+        __m512i r;
+        switch (inst.type) {
+            case NodeType::VARIABLE:
+                r = _mm512_loadu_si512(v + inst.left);
+                break;
+            case NodeType::NOT: {
+                __m512i a = _mm512_loadu_si512(s + inst.left);
+                r = _mm512_ternarylogic_epi64(a, a, a, 0x55);
+                break;
+            }
+            case NodeType::AND:
+                r = _mm512_and_si512(_mm512_loadu_si512(s + inst.left), _mm512_loadu_si512(s + inst.right));
+                break;
+            case NodeType::OR:
+                r = _mm512_or_si512(_mm512_loadu_si512(s + inst.left), _mm512_loadu_si512(s + inst.right));
+                break;
+            case NodeType::IMPLIES: {
+                // Tabela verdade de ¬A ∨ B sobre (A, B, C): 0xCF
+                __m512i b = _mm512_loadu_si512(s + inst.right);
+                r = _mm512_ternarylogic_epi64(_mm512_loadu_si512(s + inst.left), b, b, 0xCF);
+                break;
+            }
+            default:
+                r = _mm512_setzero_si512();
+                break;
+        }
+        _mm512_storeu_si512(s + i, r);
+    }
+}
+
+#endif
+
+static const SimdKernel SCALAR_KERNEL = { "scalar", 1, runScalar };
+#ifdef SIMD_X86
+static const SimdKernel AVX2_KERNEL = { "avx2", 4, runAvx2 };
+static const SimdKernel AVX512_KERNEL = { "avx512", 8, runAvx512 };
+#endif
+
+static bool cpuSupports(const std::string& name) {
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (name == "avx2") return __builtin_cpu_supports("avx2");
+    if (name == "avx512") return __builtin_cpu_supports("avx512f");
+#endif
+    return name == "scalar";
+}
+
+static const SimdKernel& detectBest() {
+#ifdef SIMD_X86
+    if (cpuSupports("avx512")) return AVX512_KERNEL;
+    if (cpuSupports("avx2")) return AVX2_KERNEL;
+#endif
+    return SCALAR_KERNEL;
+}
+
+const SimdKernel& SimdDispatch::best() {
+    static const SimdKernel& kernel = detectBest();
+    return kernel;
+}
+
+const SimdKernel& SimdDispatch::scalar() {
+    return SCALAR_KERNEL;
+}
+
+const SimdKernel& SimdDispatch::byName(const std::string& name) {
+    if (name == "auto") {
+        return best();
+    }
+    if (!cpuSupports(name)) {
+        throw std::runtime_error("Kernel SIMD indisponível nesta CPU: " + name);
+    }
+#ifdef SIMD_X86
+    if (name == "avx2") return AVX2_KERNEL;
+    if (name == "avx512") return AVX512_KERNEL;
+#endif
+    return SCALAR_KERNEL;
+}
@@ -0,0 +1,38 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include "../common/ast.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Instrução do programa bit-sliced: uma por nó, em pós-ordem
+struct BitSliceInstruction {
+    NodeType type;
+    int left;   // Índice da variável para VARIABLE, slot do operando caso contrário
+    int right;
+};
+
+// Avalia o programa sobre um bloco de `words` palavras consecutivas.
+// varWords e slots são organizados como [índice][palavra do bloco].
+typedef void (*BlockKernelFn)(const BitSliceInstruction* program, size_t size,
+                              const uint64_t* varWords, uint64_t* slots);
+
+struct SimdKernel {
+    const char* name;
+    int words;          // Palavras de 64 bits por bloco (1, 4 ou 8)
+    BlockKernelFn run;
+};
+
+class SimdDispatch {
+public:
+    // Kernel mais largo suportado pela CPU (detectado via CPUID uma única vez)
+    static const SimdKernel& best();
+
+    // Kernel pelo nome (scalar, avx2, avx512 ou auto); lança erro se indisponível
+    static const SimdKernel& byName(const std::string& name);
+
+    static const SimdKernel& scalar();
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "simplifier.h"
+#include <vector>
+
+const NodeId Simplifier::TRUE_REF;
+const NodeId Simplifier::FALSE_REF;
+
+bool Simplifier::isNegationOf(NodeId a, NodeId b) const {
+    return (!isConstant(a) && work.node(a).type == NodeType::NOT && work.node(a).left == b) ||
+           (!isConstant(b) && work.node(b).type == NodeType::NOT && work.node(b).left == a);
+}
+
+bool Simplifier::hasChild(NodeId parent, NodeType type, NodeId child) const {
+    if (isConstant(parent)) return false;
+    const ASTNode& node = work.node(parent);
+    return node.type == type && (node.left == child || node.right == child);
+}
+
+NodeId Simplifier::makeNot(NodeId child) {
+    if (child == TRUE_REF || child == FALSE_REF) {
+        stats.constants++;
+        return child == TRUE_REF ? FALSE_REF : TRUE_REF;
+    }
+    if (work.node(child).type == NodeType::NOT) {
+        stats.doubleNegations++;
+        return work.node(child).left;
+    }
+    return work.addNode(NodeType::NOT, child);
+}
+
+NodeId Simplifier::makeAnd(NodeId left, NodeId right) {
+    if (left == FALSE_REF || right == FALSE_REF) {
+        stats.constants++;
+        return FALSE_REF;
+    }
+    if (left == TRUE_REF || right == TRUE_REF) {
+        stats.constants++;
+        return left == TRUE_REF ? right : left;
+    }
+    if (left == right || hasChild(left, NodeType::AND, right)) {
+        stats.idempotence++;
+        return left;
+    }
+    if (hasChild(right, NodeType::AND, left)) {
+        stats.idempotence++;
+        return right;
+    }
+    if (isNegationOf(left, right)) {
+        stats.complements++;
+        return FALSE_REF;
+    }
+    if (hasChild(right, NodeType::OR, left)) {
+        stats.absorptions++;
+        return left;
+    }
+    if (hasChild(left, NodeType::OR, right)) {
+        stats.absorptions++;
+        return right;
+    }
+    return work.addNode(NodeType::AND, left, right);
+}
+
+NodeId Simplifier::makeOr(NodeId left, NodeId right) {
+    if (left == TRUE_REF || right == TRUE_REF) {
+        stats.constants++;
+        return TRUE_REF;
+    }
+    if (left == FALSE_REF || right == FALSE_REF) {
+        stats.constants++;
+        return left == FALSE_REF ? right : left;
+    }
+    if (left == right || hasChild(left, NodeType::OR, right)) {
+        stats.idempotence++;
+        return left;
+    }
+    if (hasChild(right, NodeType::OR, left)) {
+        stats.idempotence++;
+        return right;
+    }
+    if (isNegationOf(left, right)) {
+        stats.complements++;
+        return TRUE_REF;
+    }
+    if (hasChild(right, NodeType::AND, left)) {
+        stats.absorptions++;
+        return left;
+    }
+    if (hasChild(left, NodeType::AND, right)) {
+        stats.absorptions++;
+        return right;
+    }
+    return work.addNode(NodeType::OR, left, right);
+}
+
+Simplifier::Outcome Simplifier::simplify(const AST& input, AST& output) {
+    stats = Stats();
+    stats.nodesBefore = input.size();
+    stats.variablesBefore = input.numVariables();
+
+    if (input.empty()) {
+        output = input;
+        return FORMULA;
+    }
+
+    work = AST();
+    work.setHashConsing(true);
+
+    std::vector<NodeId> remap(input.size(), INVALID_NODE);
+    for (NodeId id = 0; id < input.size(); ++id) {
+        const ASTNode& node = input.node(id);
+        switch (node.type) {
+            case NodeType::VARIABLE:
+                remap[id] = work.addVariable(input.variableName(node.varId()));
+                break;
+            case NodeType::NOT:
+                remap[id] = makeNot(remap[node.left]);
+                break;
+            case NodeType::AND:
+                remap[id] = makeAnd(remap[node.left], remap[node.right]);
+                break;
+            case NodeType::OR:
+                remap[id] = makeOr(remap[node.left], remap[node.right]);
+                break;
+            case NodeType::IMPLIES:
+                stats.implications++;
+                remap[id] = makeOr(makeNot(remap[node.left]), remap[node.right]);
+                break;
+        }
+    }
+
+    NodeId root = remap[input.getRoot()];
+    if (root == TRUE_REF) return CONSTANT_TRUE;
+    if (root == FALSE_REF) return CONSTANT_FALSE;
+
+    // Só o que ainda é alcançável a partir da nova raiz vai para a saída
+    output = work.extract(root);
+    output.setHashConsing(input.isHashConsing());
+    work = AST();
+    output.sortVariables();
+    stats.nodesAfter = output.size();
+    stats.variablesAfter = output.numVariables();
+    return FORMULA;
+}
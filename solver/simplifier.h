@@ -0,0 +1,58 @@
+#ifndef SIMPLIFIER_H
+#define SIMPLIFIER_H
+
+#include "../common/ast.h"
+#include <cstddef>
+
+// Reescrita da AST antes da avaliação. A fórmula é reconstruída de baixo para
+// cima com hash-consing (subfórmulas iguais têm o mesmo ID) aplicando:
+//   → vira ∨:             a → b      ⇒  ¬a ∨ b
+//   dupla negação:        ¬¬x        ⇒  x
+//   idempotência:         x ∧ x      ⇒  x
+//   complementação:       x ∨ ¬x     ⇒  ⊤,   x ∧ ¬x  ⇒  ⊥
+//   absorção:             x ∧ (x ∨ y) ⇒  x,  x ∨ (x ∧ y)  ⇒  x
+//   propagação de constantes.
+// Como as constantes sempre são absorvidas pelo pai, o resultado é uma
+// fórmula sem constantes ou uma constante na raiz.
+class Simplifier {
+public:
+    enum Outcome { FORMULA, CONSTANT_TRUE, CONSTANT_FALSE };
+
+    struct Stats {
+        size_t nodesBefore;
+        size_t nodesAfter;
+        size_t variablesBefore;
+        size_t variablesAfter;
+        long long implications;
+        long long doubleNegations;
+        long long idempotence;
+        long long complements;
+        long long absorptions;
+        long long constants;
+
+        Stats() : nodesBefore(0), nodesAfter(0), variablesBefore(0), variablesAfter(0), implications(0),
+                  doubleNegations(0), idempotence(0), complements(0), absorptions(0), constants(0) {}
+    };
+
+private:
+    static const NodeId TRUE_REF = 0xFFFFFFFEu;
+    static const NodeId FALSE_REF = 0xFFFFFFFDu;
+
+    AST work;
+
+    static bool isConstant(NodeId id) { return id == TRUE_REF || id == FALSE_REF; }
+    bool isNegationOf(NodeId a, NodeId b) const;
+    bool hasChild(NodeId parent, NodeType type, NodeId child) const;
+
+    NodeId makeNot(NodeId child);
+    NodeId makeAnd(NodeId left, NodeId right);
+    NodeId makeOr(NodeId left, NodeId right);
+
+public:
+    // output recebe a fórmula simplificada quando o resultado é FORMULA
+    Outcome simplify(const AST& input, AST& output);
+
+    Stats stats;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#include "tseitin.h"
+#include "perf_counters.h"
+#include <stdexcept>
+#include <string>
+
+std::vector<Lit> SatEvaluator::encode(const AST& formula, SatSolver& solver) {
+    // As variáveis da fórmula ocupam as variáveis SAT 0..n-1
+    for (size_t v = 0; v < formula.numVariables(); ++v) {
+        solver.newVar();
+    }
+
+    // Só os nós alcançáveis a partir da raiz são codificados
+    std::vector<bool> reachable(formula.size(), false);
+    reachable[formula.getRoot()] = true;
+    for (NodeId id = static_cast<NodeId>(formula.size()); id-- > 0;) {
+        if (!reachable[id]) continue;
+        const ASTNode& node = formula.node(id);
+        if (!node.isLeaf()) reachable[node.left] = true;
+        if (node.isBinary()) reachable[node.right] = true;
+    }
+
+    std::vector<Lit> lits(formula.size(), 0);
+    for (NodeId id = 0; id < formula.size(); ++id) {
+        if (!reachable[id]) continue;
+        const ASTNode& node = formula.node(id);
+
+        if (node.type == NodeType::VARIABLE) {
+            lits[id] = makeLit(node.varId());
+            continue;
+        }
+        if (node.type == NodeType::NOT) {
+            lits[id] = negLit(lits[node.left]);
+            continue;
+        }
+
+        Lit a = lits[node.left];
+        Lit b = lits[node.right];
+        Lit g = makeLit(solver.newVar());
+
+        switch (node.type) {
+            case NodeType::AND:
+                // g ↔ a ∧ b
+                solver.addClause({ negLit(g), a });
+                solver.addClause({ negLit(g), b });
+                solver.addClause({ g, negLit(a), negLit(b) });
+                break;
+            case NodeType::OR:
+                // g ↔ a ∨ b
+                solver.addClause({ g, negLit(a) });
+                solver.addClause({ g, negLit(b) });
+                solver.addClause({ negLit(g), a, b });
+                break;
+            case NodeType::IMPLIES:
+                // g ↔ ¬a ∨ b
+                solver.addClause({ g, a });
+                solver.addClause({ g, negLit(b) });
+                solver.addClause({ negLit(g), negLit(a), b });
+                break;
+            default:
+                throw std::runtime_error("Tipo de nó desconhecido");
+        }
+        numClauses += 3;
+        lits[id] = g;
+    }
+
+    return lits;
+}
+
+bool SatEvaluator::isTautology(const AST& formula) {
+    resetMetrics();
+    if (formula.empty()) return false;
+
+    SatSolver solver;
+    solver.setDeadline(deadline);
+
+    std::vector<Lit> lits;
+    {
+        PhaseScope phase(SolverPhase::COMPILE);
+        lits = encode(formula, solver);
+
+        // Afirma ¬φ: a raiz tem que ser falsa
+        solver.addClause({ negLit(lits[formula.getRoot()]) });
+        numClauses++;
+    }
+
+    SatSolver::Result result = solver.solve();
+
+    stats = solver.stats;
+    metrics.evaluations = stats.decisions;
+    metrics.stackOperations = stats.propagations;
+    metrics.maxStackSize = stats.maxTrailSize;
+
+    if (result == SatSolver::UNKNOWN) {
+        deadline->check();
+    }
+    if (result == SatSolver::UNSATISFIABLE) {
+        return true;
+    }
+
+    model.assign(formula.numVariables(), false);
+    for (size_t v = 0; v < formula.numVariables(); ++v) {
+        model[v] = solver.modelValue(static_cast<uint32_t>(v));
+    }
+    return false;
+}
+
+void SatEvaluator::resetMetrics() {
+    metrics = Evaluator::Metrics();
+    stats = SatSolver::Stats();
+    numClauses = 0;
+    model.clear();
+}
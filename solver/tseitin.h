@@ -0,0 +1,38 @@
+#ifndef TSEITIN_H
+#define TSEITIN_H
+
+#include "../common/ast.h"
+#include "evaluator.h"
+#include "sat.h"
+#include <vector>
+
+// Decide tautologia por SAT: a negação da fórmula é codificada em CNF pela
+// transformação de Tseitin (uma variável auxiliar por conectivo binário) e
+// entregue ao solver CDCL. ¬φ insatisfatível significa que φ é tautologia;
+// um modelo de ¬φ é uma atribuição que falsifica φ.
+class SatEvaluator {
+private:
+    const Deadline* deadline;
+    std::vector<bool> model;
+
+    // Literal SAT de cada nó; NOT reaproveita o literal negado do filho
+    std::vector<Lit> encode(const AST& formula, SatSolver& solver);
+
+public:
+    SatEvaluator(const Deadline* limit = nullptr) : deadline(limit), numClauses(0) {}
+
+    bool isTautology(const AST& formula);
+
+    // Atribuição (indexada pelo ID da variável) que falsifica a fórmula,
+    // válida quando isTautology retorna false
+    const std::vector<bool>& counterexample() const { return model; }
+
+    // evaluations conta decisões, stackOperations propagações e
+    // maxStackSize o maior tamanho da trilha de atribuições
+    Evaluator::Metrics metrics;
+    SatSolver::Stats stats;
+    size_t numClauses;
+    void resetMetrics();
+};
+
+#endif